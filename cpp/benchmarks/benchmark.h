@@ -0,0 +1,59 @@
+#pragma once
+
+#include "dictionary_types.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace dictionary_benchmark
+{
+	template <typename Lambda, typename TimeUnit = std::chrono::milliseconds>
+	auto execution_time(Lambda wrapped_task)
+	{
+		auto before = std::chrono::steady_clock::now();
+		wrapped_task();
+		auto after = std::chrono::steady_clock::now();
+
+		return std::chrono::duration_cast<TimeUnit>(after - before);
+	}
+
+	template <typename Lambda>
+	double nanoseconds_per_operation(size_t operations, Lambda wrapped_task)
+	{
+		auto total = execution_time<Lambda, std::chrono::nanoseconds>(std::move(wrapped_task));
+
+		return operations != 0 ? static_cast<double>(total.count()) / static_cast<double>(operations) : 0.0;
+	}
+
+	// lowercase latin pseudo-words, 3 to 12 letters long, duplicates are possible
+	inline std::vector<dictionary_creator::utf8_string> generate_words(size_t number, uint32_t seed = 42)
+	{
+		std::mt19937 engine(seed);
+		std::uniform_int_distribution<size_t> length(3, 12);
+		std::uniform_int_distribution<int> letter('a', 'z');
+
+		std::vector<dictionary_creator::utf8_string> words;
+		words.reserve(number);
+
+		for (size_t i = 0; i != number; ++i)
+		{
+			dictionary_creator::utf8_string word(length(engine), ' ');
+			for (auto &c: word)
+			{
+				c = static_cast<char>(letter(engine));
+			}
+			words.push_back(std::move(word));
+		}
+
+		return words;
+	}
+
+	inline void report(const std::string &name, double value, const std::string &unit)
+	{
+		std::cout << '\t' << name << ": " << value << ' ' << unit << '\n';
+	}
+}
@@ -0,0 +1,69 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+	dictionary_creator::Dictionary reference(dictionary_creator::Language::English);
+	for (const auto &word: dictionary_benchmark::generate_words(number))
+	{
+		reference.add_word(word);
+	}
+
+	// the words and counters of a saved or exported dictionary, in its order
+	std::vector<std::pair<dictionary_creator::utf8_string, size_t>> sorted;
+	dictionary_creator::subset_t entries;
+	for (const auto &[letter, words]: reference.get_main_dictionary())
+	{
+		for (const auto &entry: words)
+		{
+			sorted.emplace_back(entry->get_word(), entry->get_counter());
+			entries.push_back(entry);
+		}
+	}
+
+	auto shuffled = sorted;
+	std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+
+	std::cout << "building " << sorted.size() << " words\n";
+
+	size_t built_words = 0;
+
+	auto one_by_one = dictionary_benchmark::execution_time([&]
+		{
+			dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+			for (const auto &[word, counter]: sorted)
+			{
+				dictionary.add_word(word);
+				dictionary.lookup(word)->increment_counter(counter - 1);
+			}
+			built_words = dictionary.total_words();
+		});
+	dictionary_benchmark::report("add_word() one by one", static_cast<double>(one_by_one.count()), "ms");
+
+	for (const auto &[name, input]: { std::pair{ "from_sorted(), ordered pairs", &sorted }, std::pair{ "from_sorted(), shuffled pairs", &shuffled } })
+	{
+		auto time = dictionary_benchmark::execution_time([&, &input = input]
+			{
+				built_words = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, input->begin(), input->end()).total_words();
+			});
+		dictionary_benchmark::report(name, static_cast<double>(time.count()), "ms");
+	}
+
+	auto shared = dictionary_benchmark::execution_time([&]
+		{
+			built_words = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, entries.begin(), entries.end()).total_words();
+		});
+	dictionary_benchmark::report("from_sorted(), ordered entries", static_cast<double>(shared.count()), "ms");
+
+	auto intersection = dictionary_benchmark::execution_time([&] { built_words = reference.intersection_with(reference).total_words(); });
+	dictionary_benchmark::report("intersection_with() itself", static_cast<double>(intersection.count()), "ms");
+
+	return built_words == sorted.size() ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+	class RatedEntry : public dictionary_creator::Entry
+	{
+	public:
+		RatedEntry(dictionary_creator::utf8_string word, double rating)
+			: dictionary_creator::Entry{ std::move(word) }, rating{ rating }
+		{}
+
+		double get_rating() const noexcept
+		{
+			return rating;
+		}
+
+	private:
+		double rating;
+	};
+
+	bool less_rated(const RatedEntry &a, const RatedEntry &b)
+	{
+		return a.get_rating() < b.get_rating();
+	}
+
+	// get_top<T>() as it used to be: std::function comparator, two dynamic_casts and word copies per comparison
+	dictionary_creator::subset_t type_erased_top(const dictionary_creator::Dictionary &dictionary,
+		dictionary_creator::less_comp_t<RatedEntry> &&comparator, size_t quantity)
+	{
+		auto hierarchy_aware_comp = [&comparator] (const std::shared_ptr<dictionary_creator::Entry> &a, const std::shared_ptr<dictionary_creator::Entry> &b)
+		{
+			const auto *aptr = dynamic_cast<const RatedEntry *>(a.get());
+			const auto *bptr = dynamic_cast<const RatedEntry *>(b.get());
+
+			if (aptr != nullptr && bptr != nullptr)
+			{
+				return comparator(*aptr, *bptr);
+			}
+			else if (aptr == nullptr && bptr == nullptr && a != nullptr && b != nullptr)
+			{
+				return a->get_word() < b->get_word();
+			}
+
+			return (aptr != nullptr);
+		};
+
+		size_t total = dictionary.total_words();
+		quantity = std::min(quantity, total);
+
+		dictionary_creator::subset_t entries;
+		entries.reserve(total);
+
+		for (const auto &[letter, words]: dictionary.get_main_dictionary())
+		{
+			for (const auto &word: words)
+			{
+				entries.push_back(word);
+			}
+		}
+
+		std::partial_sort(entries.begin(), entries.begin() + quantity, entries.end(), hierarchy_aware_comp);
+		entries.resize(quantity);
+
+		return entries;
+	}
+
+	void measure(const dictionary_creator::Dictionary &dictionary, size_t quantity)
+	{
+		dictionary_creator::subset_t erased, forwarded, direct;
+
+		auto erased_time = dictionary_benchmark::execution_time([&] { erased = type_erased_top(dictionary, less_rated, quantity); });
+		auto forwarded_time = dictionary_benchmark::execution_time([&] { forwarded = dictionary.get_top(dictionary_creator::less_comp_t<RatedEntry>{ less_rated }, quantity); });
+		auto direct_time = dictionary_benchmark::execution_time([&] { direct = dictionary.get_top<RatedEntry>(less_rated, quantity); });
+
+		std::cout << "top " << quantity << " of " << dictionary.total_words() << " words"
+			<< (erased.size() == direct.size() && forwarded.size() == direct.size() ? "" : " (MISMATCH)") << '\n';
+		dictionary_benchmark::report("std::function, dynamic_cast per comparison", static_cast<double>(erased_time.count()), "ms");
+		dictionary_benchmark::report("get_top(less_comp_t<T>)", static_cast<double>(forwarded_time.count()), "ms");
+		dictionary_benchmark::report("get_top<T>(callable)", static_cast<double>(direct_time.count()), "ms");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+	dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+
+	// half of the words get a rating, the other half stays plain entries
+	size_t i = 0;
+	for (auto &word: dictionary_benchmark::generate_words(number))
+	{
+		if (++i % 2 == 0)
+		{
+			dictionary.add_word<RatedEntry>(std::move(word), static_cast<double>(i % 1000));
+		}
+		else
+		{
+			dictionary.add_word(std::move(word));
+		}
+	}
+
+	for (size_t quantity: { size_t{ 100 }, dictionary.total_words() })
+	{
+		measure(dictionary, quantity);
+	}
+
+	return 0;
+}
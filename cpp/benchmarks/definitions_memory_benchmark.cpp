@@ -0,0 +1,113 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <cstdlib>
+#include <random>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+	size_t heap_in_use()
+	{
+#if defined(__GLIBC__)
+		return mallinfo2().uordblks;
+#else
+		return 0;
+#endif
+	}
+
+	// 1 to 3 parts of speech with 1 to 4 meanings each, a fifth of the meanings is shared among words
+	dictionary_creator::definitions_t make_definitions(std::mt19937 &engine, const std::vector<dictionary_creator::utf8_string> &vocabulary)
+	{
+		static const std::vector<dictionary_creator::utf8_string> parts_of_speech
+		{
+			"noun", "verb", "adjective", "adverb", "pronoun", "preposition", "conjunction", "interjection"
+		};
+
+		std::uniform_int_distribution<size_t> parts(1, 3), meanings(1, 4), part(0, parts_of_speech.size() - 1),
+			length(3, 12), word(0, vocabulary.size() - 1), common(0, 999), chance(0, 4);
+
+		dictionary_creator::definitions_t definitions;
+
+		for (size_t p = parts(engine); p != 0; --p)
+		{
+			auto &current = definitions[parts_of_speech[part(engine)]];
+
+			for (size_t m = meanings(engine); m != 0; --m)
+			{
+				if (chance(engine) == 0)
+				{
+					current.insert("a common meaning number " + std::to_string(common(engine)));
+					continue;
+				}
+
+				dictionary_creator::utf8_string meaning;
+				for (size_t w = length(engine); w != 0; --w)
+				{
+					meaning += vocabulary[word(engine)];
+					meaning += ' ';
+				}
+				current.insert(std::move(meaning));
+			}
+		}
+
+		return definitions;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+
+	const auto vocabulary = dictionary_benchmark::generate_words(5'000, 7);
+	const auto words = dictionary_benchmark::generate_words(number);
+
+	dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+	for (const auto &word: words)
+	{
+		dictionary.add_word(word);
+	}
+
+	std::vector<dictionary_creator::definitions_t> generated;
+	generated.reserve(dictionary.total_words());
+
+	std::mt19937 engine(13);
+	for (size_t i = 0; i != dictionary.total_words(); ++i)
+	{
+		generated.push_back(make_definitions(engine, vocabulary));
+	}
+
+	const size_t heap_with_maps = heap_in_use();
+	auto copies = generated;
+	const size_t maps_bytes = heap_in_use() - heap_with_maps;
+	copies.clear();
+	copies.shrink_to_fit();
+
+	size_t i = 0;
+	const size_t heap_before = heap_in_use();
+	auto defining_time = dictionary_benchmark::execution_time([&]
+		{
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					entry->define([&] (auto) { return generated[i++]; });
+				}
+			}
+		});
+	const size_t compact_bytes = heap_in_use() - heap_before;
+
+	const auto words_number = static_cast<double>(dictionary.total_words());
+	std::cout << dictionary.total_words() << " defined words, " << dictionary_creator::StringPool::shared().size() << " pooled strings\n";
+	dictionary_benchmark::report("definitions_t maps", static_cast<double>(maps_bytes) / words_number, "bytes per word");
+	dictionary_benchmark::report("compact definitions with the pool", static_cast<double>(compact_bytes) / words_number, "bytes per word");
+	dictionary_benchmark::report("memory_usage() definitions", static_cast<double>(dictionary.memory_usage().overall.definitions) / words_number, "bytes per word");
+	dictionary_benchmark::report("StringPool::memory_usage()", static_cast<double>(dictionary_creator::StringPool::shared().memory_usage()) / words_number, "bytes per word");
+	dictionary_benchmark::report("defining took", static_cast<double>(defining_time.count()), "ms");
+
+	return 0;
+}
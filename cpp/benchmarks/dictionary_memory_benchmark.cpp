@@ -0,0 +1,46 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <cstdlib>
+
+namespace
+{
+	void measure(size_t number)
+	{
+		dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+
+		for (const auto &word: dictionary_benchmark::generate_words(number))
+		{
+			dictionary.add_word(word);
+		}
+
+		dictionary_creator::MemoryReport report;
+		auto accounting_time = dictionary_benchmark::execution_time([&report, &dictionary] { report = dictionary.memory_usage(); });
+
+		const auto total = static_cast<double>(dictionary.total_words());
+		const auto &overall = report.overall;
+
+		std::cout << number << " generated words, " << dictionary.total_words() << " unique words\n";
+		dictionary_benchmark::report("total", static_cast<double>(overall.total()) / total, "bytes per word");
+		dictionary_benchmark::report("word strings", static_cast<double>(overall.word_strings) / total, "bytes per word");
+		dictionary_benchmark::report("entries", static_cast<double>(overall.entries) / total, "bytes per word");
+		dictionary_benchmark::report("container nodes", static_cast<double>(overall.container_nodes) / total, "bytes per word");
+		dictionary_benchmark::report("memory_usage() took", static_cast<double>(accounting_time.count()), "ms");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t largest = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+	for (size_t number: { size_t{ 10'000 }, size_t{ 1'000'000 }, size_t{ 10'000'000 } })
+	{
+		if (number <= largest)
+		{
+			measure(number);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+#include "frozen_dictionary.h"
+
+#include <cstdlib>
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+	auto words = dictionary_benchmark::generate_words(number);
+	auto misses = dictionary_benchmark::generate_words(number, 4242);
+
+	dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+	for (const auto &word: words)
+	{
+		dictionary.add_word(word);
+	}
+
+	std::cout << "Frozen dictionary, " << dictionary.total_words() << " unique words\n";
+
+	dictionary_creator::FrozenDictionary frozen(dictionary_creator::Language::English, {});
+	auto freeze_time = dictionary_benchmark::execution_time([&frozen, &dictionary] { frozen = dictionary.freeze(); });
+	dictionary_benchmark::report("freeze()", static_cast<double>(freeze_time.count()), "ms");
+
+	size_t found = 0;
+
+	auto dictionary_hits = dictionary_benchmark::nanoseconds_per_operation(words.size(), [&found, &dictionary, &words]
+		{
+			for (const auto &word: words)
+			{
+				found += dictionary.lookup(word) != nullptr;
+			}
+		});
+	dictionary_benchmark::report("Dictionary::lookup() hit", dictionary_hits, "ns");
+
+	auto frozen_hits = dictionary_benchmark::nanoseconds_per_operation(words.size(), [&found, &frozen, &words]
+		{
+			for (const auto &word: words)
+			{
+				found += frozen.lookup(word) != nullptr;
+			}
+		});
+	dictionary_benchmark::report("FrozenDictionary::lookup() hit", frozen_hits, "ns");
+
+	auto dictionary_misses = dictionary_benchmark::nanoseconds_per_operation(misses.size(), [&found, &dictionary, &misses]
+		{
+			for (const auto &word: misses)
+			{
+				found += dictionary.lookup(word) != nullptr;
+			}
+		});
+	dictionary_benchmark::report("Dictionary::lookup() mostly miss", dictionary_misses, "ns");
+
+	auto frozen_misses = dictionary_benchmark::nanoseconds_per_operation(misses.size(), [&found, &frozen, &misses]
+		{
+			for (const auto &word: misses)
+			{
+				found += frozen.contains_word(word);
+			}
+		});
+	dictionary_benchmark::report("FrozenDictionary::contains_word() mostly miss", frozen_misses, "ns");
+
+	std::cout << "\t(" << found << " hits in total)" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char **argv)
+{
+	const size_t vocabulary_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+	constexpr size_t quantity = 100;
+
+	const auto vocabulary = dictionary_benchmark::generate_words(vocabulary_size);
+
+	// roughly Zipfian counters, the author prefers a shifted part of the vocabulary
+	std::mt19937 engine(11);
+	auto make_dictionary = [&] (size_t tokens, size_t shift)
+		{
+			std::uniform_real_distribution<double> uniform(0.0, std::log(static_cast<double>(vocabulary_size)));
+
+			dictionary_creator::Dictionary result(dictionary_creator::Language::English);
+			for (size_t i = 0; i != tokens; ++i)
+			{
+				const auto rank = static_cast<size_t>(std::exp(uniform(engine))) - 1;
+				result.add_word(vocabulary[(rank + shift) % vocabulary_size]);
+			}
+			return result;
+		};
+
+	const auto reference = make_dictionary(4 * vocabulary_size, 0);
+	const auto author = make_dictionary(vocabulary_size, 50);
+
+	std::cout << author.total_words() << " words of the author against " << reference.total_words() << " of the reference\n";
+
+	std::vector<dictionary_creator::Keyword> found;
+	const auto joined = dictionary_benchmark::execution_time([&] { found = author.keywords(reference, quantity); });
+	dictionary_benchmark::report("keywords()", static_cast<double>(joined.count()), "ms");
+
+	// what user code does without it: a lookup per word and every candidate kept
+	std::vector<std::pair<double, std::shared_ptr<dictionary_creator::Entry>>> scored;
+	const auto looked_up = dictionary_benchmark::execution_time([&]
+		{
+			double own_total = 0.0;
+			double theirs_total = 0.0;
+			for (const auto &[letter, entries]: author.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					own_total += static_cast<double>(entry->get_counter());
+				}
+			}
+			for (const auto &[letter, entries]: reference.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					theirs_total += static_cast<double>(entry->get_counter());
+				}
+			}
+
+			const double total = own_total + theirs_total;
+			for (const auto &[letter, entries]: author.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					const auto other = reference.lookup(entry->get_word());
+					const double a = static_cast<double>(entry->get_counter());
+					const double b = other ? static_cast<double>(other->get_counter()) : 0.0;
+
+					if (a * theirs_total > b * own_total)
+					{
+						auto cell = [total] (double observed, double expected) { return observed > 0.0 ? observed * std::log(observed / expected) : 0.0; };
+						const double rest = total - a - b;
+
+						const double score = cell(a, own_total * (a + b) / total) + cell(b, theirs_total * (a + b) / total)
+							+ cell(own_total - a, own_total * rest / total) + cell(theirs_total - b, theirs_total * rest / total);
+						scored.emplace_back(2.0 * score, entry);
+					}
+				}
+			}
+
+			const auto last = scored.begin() + static_cast<std::ptrdiff_t>(std::min(quantity, scored.size()));
+			std::partial_sort(scored.begin(), last, scored.end(), [] (const auto &a, const auto &b) { return a.first > b.first; });
+		});
+	dictionary_benchmark::report("lookup per word", static_cast<double>(looked_up.count()), "ms");
+
+	return !found.empty() && std::abs(found.front().score - scored.front().first) <= 1e-9 * scored.front().first ? 0 : 1;
+}
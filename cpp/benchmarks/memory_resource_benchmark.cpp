@@ -0,0 +1,73 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace
+{
+	// a batch job: lines parsed into small dictionaries, merged into one, queried once and thrown away
+	void measure(const std::string &name, const std::vector<dictionary_creator::utf8_string> &words, std::unique_ptr<std::pmr::memory_resource> resource)
+	{
+		constexpr size_t words_per_line = 12;
+
+		auto *used = resource ? resource.get() : std::pmr::get_default_resource();
+		std::optional<dictionary_creator::Dictionary> dictionary;
+		size_t found = 0;
+
+		auto build_time = dictionary_benchmark::execution_time([&]
+			{
+				dictionary.emplace(dictionary_creator::Language::English, used);
+
+				for (size_t first = 0; first < words.size(); first += words_per_line)
+				{
+					dictionary_creator::Dictionary line(dictionary_creator::Language::English, used);
+					for (size_t i = first; i != std::min(first + words_per_line, words.size()); ++i)
+					{
+						line.add_word(words[i]);
+					}
+					dictionary->merge(std::move(line));
+				}
+			});
+
+		auto query_time = dictionary_benchmark::execution_time([&]
+			{
+				found = dictionary->get_top(dictionary_creator::ComparisonType::MostFrequent, 100).size();
+			});
+
+		auto teardown_time = dictionary_benchmark::execution_time([&]
+			{
+				dictionary.reset();
+				resource.reset();
+			});
+
+		std::cout << name << (found == 100 ? "" : " (MISMATCH)") << '\n';
+		dictionary_benchmark::report("build", static_cast<double>(build_time.count()), "ms");
+		dictionary_benchmark::report("top 100", static_cast<double>(query_time.count()), "ms");
+		dictionary_benchmark::report("teardown", static_cast<double>(teardown_time.count()), "ms");
+		dictionary_benchmark::report("total", static_cast<double>((build_time + query_time + teardown_time).count()), "ms");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+
+	// a narrower alphabet than generate_words() gives, so that words repeat as they do in texts
+	auto words = dictionary_benchmark::generate_words(number);
+	for (auto &word: words)
+	{
+		word.resize(std::min<size_t>(word.size(), 5));
+	}
+
+	std::cout << number << " words\n";
+
+	measure("default heap", words, nullptr);
+	measure("unsynchronized_pool_resource", words, std::make_unique<std::pmr::unsynchronized_pool_resource>());
+	measure("monotonic_buffer_resource", words, std::make_unique<std::pmr::monotonic_buffer_resource>());
+
+	return 0;
+}
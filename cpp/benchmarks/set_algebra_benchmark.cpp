@@ -0,0 +1,121 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+#include "thread_pool.h"
+
+#include <cstdlib>
+#include <optional>
+
+namespace
+{
+	dictionary_creator::Dictionary dictionary_of(const std::vector<dictionary_creator::utf8_string> &words, size_t first, size_t last)
+	{
+		dictionary_creator::Dictionary result(dictionary_creator::Language::English);
+		for (size_t i = first; i != last; ++i)
+		{
+			result.add_word(words[i]);
+		}
+		return result;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+	constexpr size_t partial_size = 500;
+
+	// short words make the two halves overlap a good deal
+	auto words = dictionary_benchmark::generate_words(2 * number);
+	for (auto &word: words)
+	{
+		word.resize(std::min<size_t>(word.size(), 5));
+	}
+
+	const auto left = dictionary_of(words, 0, number);
+	const auto right = dictionary_of(words, number, 2 * number);
+
+	std::cout << left.total_words() << " and " << right.total_words() << " words\n";
+
+	size_t result_words = 0;
+
+	auto sum = dictionary_benchmark::execution_time([&] { result_words += (left + right).total_words(); });
+	dictionary_benchmark::report("merge", static_cast<double>(sum.count()), "ms");
+
+	auto difference = dictionary_benchmark::execution_time([&] { result_words += (left - right).total_words(); });
+	dictionary_benchmark::report("subtract", static_cast<double>(difference.count()), "ms");
+
+	auto intersection = dictionary_benchmark::execution_time([&] { result_words += (left * right).total_words(); });
+	dictionary_benchmark::report("intersection_with", static_cast<double>(intersection.count()), "ms");
+
+	dictionary_creator::ThreadPool pool;
+	const auto threads = " on " + std::to_string(pool.size()) + " threads";
+
+	auto parallel_sum = dictionary_benchmark::execution_time([&] { result_words += dictionary_creator::Dictionary(left).merge(right, pool).total_words(); });
+	dictionary_benchmark::report("merge" + threads, static_cast<double>(parallel_sum.count()), "ms");
+
+	auto parallel_difference = dictionary_benchmark::execution_time([&] { result_words += dictionary_creator::Dictionary(left).subtract(right, pool).total_words(); });
+	dictionary_benchmark::report("subtract" + threads, static_cast<double>(parallel_difference.count()), "ms");
+
+	auto parallel_intersection = dictionary_benchmark::execution_time([&] { result_words += left.intersection_with(right, pool).total_words(); });
+	dictionary_benchmark::report("intersection_with" + threads, static_cast<double>(parallel_intersection.count()), "ms");
+
+	// interning once pays off when the same dictionaries take part in many operations
+	std::optional<dictionary_creator::InternedDictionary> interned_left, interned_right;
+	auto interning = dictionary_benchmark::execution_time([&] { interned_left.emplace(left.intern()); interned_right.emplace(right.intern()); });
+	dictionary_benchmark::report("intern() both", static_cast<double>(interning.count()), "ms");
+
+	auto interned_sum = dictionary_benchmark::execution_time([&] { result_words += dictionary_creator::InternedDictionary(*interned_left).merge(*interned_right).total_words(); });
+	dictionary_benchmark::report("interned merge", static_cast<double>(interned_sum.count()), "ms");
+
+	auto interned_difference = dictionary_benchmark::execution_time([&] { result_words += dictionary_creator::InternedDictionary(*interned_left).subtract(*interned_right).total_words(); });
+	dictionary_benchmark::report("interned subtract", static_cast<double>(interned_difference.count()), "ms");
+
+	auto interned_intersection = dictionary_benchmark::execution_time([&] { result_words += interned_left->intersection_with(*interned_right).total_words(); });
+	dictionary_benchmark::report("interned intersection_with", static_cast<double>(interned_intersection.count()), "ms");
+
+	auto restoring = dictionary_benchmark::execution_time([&] { result_words += dictionary_creator::Dictionary::from_interned(*interned_left).total_words(); });
+	dictionary_benchmark::report("from_interned()", static_cast<double>(restoring.count()), "ms");
+
+	// a day's changes: one word in a hundred counted again, added or removed
+	auto today = left;
+	for (size_t i = 0; i + 1 < number; i += 100)
+	{
+		today.add_word(words[i]);
+		today.add_word(words[number + i]);
+		today.remove_word(words[i + 1]);
+	}
+
+	dictionary_creator::DictionaryDelta delta;
+	auto diff = dictionary_benchmark::execution_time([&] { delta = left.diff(today); });
+	dictionary_benchmark::report("diff() of " + std::to_string(delta.added.size() + delta.removed.size() + delta.counters.size()) + " changes",
+		static_cast<double>(diff.count()), "ms");
+
+	auto applying = dictionary_benchmark::execution_time([&] { auto replica = left; result_words += replica.apply(delta).total_words(); });
+	dictionary_benchmark::report("apply() to a copy", static_cast<double>(applying.count()), "ms");
+
+	// a job merging the dictionaries of its documents one after another
+	std::vector<dictionary_creator::Dictionary> partials;
+	for (size_t first = 0; first < 2 * number; first += partial_size)
+	{
+		partials.push_back(dictionary_of(words, first, std::min(first + partial_size, 2 * number)));
+	}
+
+	auto merge_all = dictionary_benchmark::execution_time([&]
+		{
+			result_words += dictionary_creator::Dictionary::merge_all(partials).total_words();
+		});
+	dictionary_benchmark::report(std::to_string(partials.size()) + " partial dictionaries by merge_all()", static_cast<double>(merge_all.count()), "ms");
+
+	auto partial_merges = dictionary_benchmark::execution_time([&]
+		{
+			dictionary_creator::Dictionary total(dictionary_creator::Language::English);
+			for (auto &partial: partials)
+			{
+				total.merge(std::move(partial));
+			}
+			result_words += total.total_words();
+		});
+	dictionary_benchmark::report(std::to_string(partials.size()) + " partial dictionaries merged", static_cast<double>(partial_merges.count()), "ms");
+
+	return result_words != 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <cstdlib>
+
+namespace
+{
+	double lookup_time(const dictionary_creator::Dictionary &dictionary, const std::vector<dictionary_creator::utf8_string> &words, size_t &found)
+	{
+		return dictionary_benchmark::nanoseconds_per_operation(words.size(), [&]
+			{
+				for (const auto &word: words)
+				{
+					found += dictionary.lookup(word) != nullptr ? 1 : 0;
+				}
+			});
+	}
+
+	// the latin words with their first letters mapped onto а to п, so that every word is a cyrillic one
+	std::vector<dictionary_creator::utf8_string> cyrillic(const std::vector<dictionary_creator::utf8_string> &words)
+	{
+		std::vector<dictionary_creator::utf8_string> result;
+		result.reserve(words.size());
+
+		for (const auto &word: words)
+		{
+			dictionary_creator::utf8_string converted{ '\xD0', static_cast<char>(0xB0 + (word.front() - 'a') % 16) };
+			result.push_back(converted + word.substr(1));
+		}
+
+		return result;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+
+	// only five letters of the alphabet are present
+	auto sparse_words = dictionary_benchmark::generate_words(number, 42);
+	for (auto &word: sparse_words)
+	{
+		word.front() = static_cast<char>('a' + (word.front() - 'a') % 5);
+	}
+
+	dictionary_creator::Dictionary sparse(dictionary_creator::Language::English);
+	for (const auto &word: sparse_words)
+	{
+		sparse.add_word(word);
+	}
+
+	auto missing_letters = dictionary_benchmark::generate_words(number, 7);
+	for (auto &word: missing_letters)
+	{
+		word.front() = static_cast<char>('f' + (word.front() - 'a') % 21);
+	}
+
+	const auto latin = dictionary_benchmark::generate_words(number, 9);
+	const auto russian_words = cyrillic(dictionary_benchmark::generate_words(number, 42));
+
+	dictionary_creator::Dictionary russian(dictionary_creator::Language::Russian);
+	for (const auto &word: russian_words)
+	{
+		russian.add_word(word);
+	}
+
+	size_t found = 0;
+
+	std::cout << "English, " << sparse.total_words() << " words under 5 letters\n";
+	dictionary_benchmark::report("hits", lookup_time(sparse, sparse_words, found), "ns");
+	dictionary_benchmark::report("misses, letter absent", lookup_time(sparse, missing_letters, found), "ns");
+
+	std::cout << "Russian, " << russian.total_words() << " words\n";
+	dictionary_benchmark::report("hits", lookup_time(russian, russian_words, found), "ns");
+	dictionary_benchmark::report("misses, latin words", lookup_time(russian, latin, found), "ns");
+
+	// the other dictionary lacks most letters of this one
+	dictionary_creator::Dictionary full(dictionary_creator::Language::English);
+	for (const auto &word: missing_letters)
+	{
+		full.add_word(word);
+	}
+	full.add_word("apple");
+	sparse.add_word("apple");
+
+	size_t common = 0;
+	const auto intersection = dictionary_benchmark::nanoseconds_per_operation(100, [&]
+		{
+			for (size_t i = 0; i != 100; ++i)
+			{
+				common += full.intersection_with(sparse).total_words();
+			}
+		});
+	std::cout << "intersection_with, 5 of 21 letters shared\n";
+	dictionary_benchmark::report("per intersection", intersection / 1000.0, "us");
+
+	return found != 0 && common != 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+#include "dictionary_language.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+	// get_top() as it used to be: every entry copied out, then partially sorted
+	dictionary_creator::subset_t copied_top(const dictionary_creator::Dictionary &dictionary, dictionary_creator::ComparisonType criterion, size_t quantity)
+	{
+		quantity = std::min(quantity, dictionary.total_words());
+
+		dictionary_creator::subset_t entries;
+		entries.reserve(dictionary.total_words());
+
+		for (const auto &[letter, words]: dictionary.get_main_dictionary())
+		{
+			entries.insert(entries.end(), words.begin(), words.end());
+		}
+
+		std::partial_sort(entries.begin(), entries.begin() + quantity, entries.end(),
+			dictionary_creator::criteria_dependent_sorters[static_cast<size_t>(criterion)]);
+		entries.resize(quantity);
+
+		return entries;
+	}
+
+	void measure(const dictionary_creator::Dictionary &dictionary, dictionary_creator::ComparisonType criterion, const char *name,
+		size_t quantity, dictionary_creator::ThreadPool &pool)
+	{
+		dictionary_creator::subset_t copied, heap, parallel;
+
+		auto copied_time = dictionary_benchmark::execution_time([&] { copied = copied_top(dictionary, criterion, quantity); });
+		auto heap_time = dictionary_benchmark::execution_time([&] { heap = dictionary.get_top(criterion, quantity); });
+		auto parallel_time = dictionary_benchmark::execution_time([&] { parallel = dictionary.get_top(criterion, quantity, pool); });
+
+		std::cout << name << ", top " << quantity << " of " << dictionary.total_words() << " words"
+			<< (copied.size() == heap.size() && heap == parallel ? "" : " (MISMATCH)") << '\n';
+		dictionary_benchmark::report("copied and partially sorted", static_cast<double>(copied_time.count()), "ms");
+		dictionary_benchmark::report("get_top()", static_cast<double>(heap_time.count()), "ms");
+		dictionary_benchmark::report("get_top() on " + std::to_string(pool.size()) + " threads", static_cast<double>(parallel_time.count()), "ms");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+	dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+	for (auto &word: dictionary_benchmark::generate_words(number))
+	{
+		dictionary.add_word(std::move(word));
+	}
+
+	dictionary_creator::ThreadPool pool;
+
+	for (size_t quantity: { size_t{ 20 }, size_t{ 1'000 } })
+	{
+		measure(dictionary, dictionary_creator::ComparisonType::MostFrequent, "MostFrequent", quantity, pool);
+		measure(dictionary, dictionary_creator::ComparisonType::Longest, "Longest", quantity, pool);
+	}
+
+	// what the Longest criterion used to compare: lengths counted over copies of both words every time
+	dictionary_creator::subset_t counted, cached;
+	auto counted_time = dictionary_benchmark::execution_time([&]
+		{
+			counted = dictionary.get_top<dictionary_creator::Entry>([] (const dictionary_creator::Entry &a, const dictionary_creator::Entry &b)
+				{
+					return dictionary_creator::utf8_length(a.get_word()) > dictionary_creator::utf8_length(b.get_word());
+				}, 20);
+		});
+	auto cached_time = dictionary_benchmark::execution_time([&] { cached = dictionary.get_top(dictionary_creator::ComparisonType::Longest, 20); });
+
+	std::cout << "Longest, lengths counted against cached ones" << (counted == cached ? "" : " (MISMATCH)") << '\n';
+	dictionary_benchmark::report("utf8_length() per comparison", static_cast<double>(counted_time.count()), "ms");
+	dictionary_benchmark::report("Entry::get_length()", static_cast<double>(cached_time.count()), "ms");
+
+	// every word defined, with one to six meanings
+	const auto defined_number = std::min<size_t>(number, 200'000);
+	dictionary_creator::Dictionary defined(dictionary_creator::Language::English);
+	for (auto &word: dictionary_benchmark::generate_words(defined_number, 7))
+	{
+		defined.add_word(std::move(word));
+	}
+
+	const auto definer = [] (const dictionary_creator::utf8_string &word)
+		{
+			dictionary_creator::definitions_t definitions;
+			for (size_t i = 0; i <= word.size() % 6; ++i)
+			{
+				definitions["noun"].insert(word + " meaning " + std::to_string(i));
+			}
+			return definitions;
+		};
+
+	for (const auto &[letter, words]: defined.get_main_dictionary())
+	{
+		for (const auto &entry: words)
+		{
+			entry->define(definer);
+		}
+	}
+
+	for (size_t quantity: { size_t{ 20 }, size_t{ 1'000 } })
+	{
+		measure(defined, dictionary_creator::ComparisonType::MostAmbiguous, "MostAmbiguous, fully defined", quantity, pool);
+	}
+
+	return 0;
+}
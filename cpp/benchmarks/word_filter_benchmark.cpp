@@ -0,0 +1,61 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <cstdlib>
+
+namespace
+{
+	// the lookups a contains_word() call does, counting the words found so that nothing is optimized away
+	double lookup_time(const dictionary_creator::Dictionary &dictionary, const std::vector<dictionary_creator::utf8_string> &words, size_t &found)
+	{
+		found = 0;
+
+		return dictionary_benchmark::nanoseconds_per_operation(words.size(), [&]
+			{
+				for (const auto &word: words)
+				{
+					found += dictionary.lookup(word) != nullptr ? 1 : 0;
+				}
+			});
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+
+	dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+
+	auto present = dictionary_benchmark::generate_words(number, 42);
+	for (const auto &word: present)
+	{
+		dictionary.add_word(word);
+	}
+
+	// capitalized, so none of them can be in the dictionary
+	auto absent = dictionary_benchmark::generate_words(number, 7);
+	for (auto &word: absent)
+	{
+		word.front() = static_cast<char>(word.front() - 'a' + 'A');
+	}
+
+	std::cout << "lookups in " << dictionary.total_words() << " words\n";
+
+	size_t found = 0;
+	dictionary_benchmark::report("misses without a filter", lookup_time(dictionary, absent, found), "ns");
+	dictionary_benchmark::report("hits without a filter", lookup_time(dictionary, present, found), "ns");
+
+	for (double rate: { 0.01, 0.001 })
+	{
+		auto filtered = dictionary;
+
+		auto build_time = dictionary_benchmark::execution_time([&] { filtered.enable_word_filter(rate); });
+		std::cout << "word filter, false positive rate " << rate << '\n';
+		dictionary_benchmark::report("built in", static_cast<double>(build_time.count()), "ms");
+		dictionary_benchmark::report("misses", lookup_time(filtered, absent, found), "ns");
+		dictionary_benchmark::report("hits", lookup_time(filtered, present, found), "ns");
+	}
+
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char **argv)
+{
+	const size_t candidates = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000;
+	constexpr size_t vocabulary_size = 100'000;
+	constexpr size_t words_per_dictionary = 5'000;
+	constexpr size_t exact_candidates = 100;
+
+	const auto vocabulary = dictionary_benchmark::generate_words(vocabulary_size);
+
+	// every candidate draws its words from a window of the vocabulary, so neighbouring ones overlap a good deal
+	std::mt19937 engine(7);
+	auto make_dictionary = [&] (size_t window_start)
+		{
+			std::uniform_int_distribution<size_t> offset(0, 4 * words_per_dictionary);
+
+			dictionary_creator::Dictionary result(dictionary_creator::Language::English);
+			for (size_t i = 0; i != words_per_dictionary; ++i)
+			{
+				result.add_word(vocabulary[(window_start + offset(engine)) % vocabulary_size]);
+			}
+			return result;
+		};
+
+	const auto query = make_dictionary(0);
+
+	std::vector<dictionary_creator::Dictionary> dictionaries;
+	std::vector<dictionary_creator::WordSketch> sketches;
+	for (size_t i = 0; i != candidates; ++i)
+	{
+		dictionaries.push_back(make_dictionary(i * vocabulary_size / candidates / 8));
+		sketches.push_back(dictionaries.back().get_word_sketch());
+	}
+
+	std::cout << candidates << " candidates of about " << dictionaries.front().total_words() << " words\n";
+
+	const auto query_sketch = query.get_word_sketch();
+	std::vector<double> estimates(candidates);
+
+	const auto sweep = dictionary_benchmark::nanoseconds_per_operation(candidates, [&]
+		{
+			for (size_t i = 0; i != candidates; ++i)
+			{
+				estimates[i] = query_sketch.jaccard(sketches[i]);
+			}
+		});
+	dictionary_benchmark::report("sketch sweep", sweep / 1000.0, "us per candidate");
+
+	const size_t exact_number = std::min(candidates, exact_candidates);
+	std::vector<double> exact(exact_number);
+
+	const auto exact_sweep = dictionary_benchmark::nanoseconds_per_operation(exact_number, [&]
+		{
+			for (size_t i = 0; i != exact_number; ++i)
+			{
+				const auto shared = static_cast<double>(query.intersection_with(dictionaries[i]).total_words());
+				exact[i] = shared / (static_cast<double>(query.total_words() + dictionaries[i].total_words()) - shared);
+			}
+		});
+	dictionary_benchmark::report("exact intersection_with sweep", exact_sweep / 1000.0, "us per candidate");
+
+	double error = 0.0;
+	for (size_t i = 0; i != exact_number; ++i)
+	{
+		error += std::abs(estimates[i] - exact[i]);
+	}
+	dictionary_benchmark::report("mean absolute error of jaccard()", error / static_cast<double>(exact_number), "");
+
+	dictionary_creator::Dictionary maintained(dictionary_creator::Language::English);
+	const auto plain_insertion = dictionary_benchmark::nanoseconds_per_operation(vocabulary_size, [&]
+		{
+			for (const auto &word: vocabulary)
+			{
+				maintained.add_word(word);
+			}
+		});
+
+	dictionary_creator::Dictionary sketched(dictionary_creator::Language::English);
+	sketched.enable_word_sketch();
+	const auto sketched_insertion = dictionary_benchmark::nanoseconds_per_operation(vocabulary_size, [&]
+		{
+			for (const auto &word: vocabulary)
+			{
+				sketched.add_word(word);
+			}
+		});
+
+	dictionary_benchmark::report("add_word() without a sketch", plain_insertion, "ns");
+	dictionary_benchmark::report("add_word() keeping a sketch", sketched_insertion, "ns");
+
+	return sketched.total_words() == maintained.total_words() ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "benchmark.h"
+
+#include "dictionary.h"
+#include "word_trie.h"
+
+#include <cstdlib>
+
+namespace
+{
+	// stems with a handful of inflectional endings, as in russian or german texts
+	std::vector<dictionary_creator::utf8_string> generate_inflections(size_t number)
+	{
+		const std::vector<dictionary_creator::utf8_string> endings{ "", "e", "en", "er", "es", "em", "ung", "ungen", "lich", "keit" };
+
+		auto stems = dictionary_benchmark::generate_words(number / endings.size() + 1);
+
+		std::vector<dictionary_creator::utf8_string> words;
+		words.reserve(number);
+
+		for (const auto &stem: stems)
+		{
+			for (const auto &ending: endings)
+			{
+				if (words.size() == number)
+				{
+					return words;
+				}
+				words.push_back(stem + ending);
+			}
+		}
+
+		return words;
+	}
+
+	void measure(const std::string &title, const std::vector<dictionary_creator::utf8_string> &words)
+	{
+		dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+		for (const auto &word: words)
+		{
+			dictionary.add_word(word);
+		}
+
+		dictionary_creator::WordTrie trie(dictionary_creator::Language::English);
+		auto build_time = dictionary_benchmark::execution_time([&trie, &dictionary] { trie = dictionary_creator::WordTrie(dictionary); });
+
+		const auto total = static_cast<double>(dictionary.total_words());
+
+		std::cout << title << ", " << dictionary.total_words() << " unique words\n";
+		dictionary_benchmark::report("Dictionary", static_cast<double>(dictionary.memory_usage().overall.total()) / total, "bytes per word");
+		dictionary_benchmark::report("WordTrie", static_cast<double>(trie.memory_usage()) / total, "bytes per word");
+		dictionary_benchmark::report("WordTrie built in", static_cast<double>(build_time.count()), "ms");
+
+		size_t found = 0;
+		auto lookup = dictionary_benchmark::nanoseconds_per_operation(words.size(), [&found, &trie, &words]
+			{
+				for (const auto &word: words)
+				{
+					found += trie.contains_word(word);
+				}
+			});
+		dictionary_benchmark::report("WordTrie::contains_word()", lookup, "ns");
+		std::cout << "\t(" << found << " hits in total)" << std::endl;
+
+		// the first pass sorts every letter, later ones walk the order kept from it
+		size_t iterated = 0;
+		auto iterate = [&iterated, &trie]
+			{
+				for (const auto &letter: trie.get_letters())
+				{
+					trie.for_each_in_letter(letter, [&iterated] (const dictionary_creator::utf8_string &word, size_t) { iterated += word.size(); });
+				}
+			};
+		dictionary_benchmark::report("WordTrie::for_each_in_letter(), first pass", dictionary_benchmark::nanoseconds_per_operation(dictionary.total_words(), iterate), "ns per word");
+		dictionary_benchmark::report("WordTrie::for_each_in_letter(), next passes", dictionary_benchmark::nanoseconds_per_operation(dictionary.total_words(), iterate), "ns per word");
+		std::cout << "\t(" << iterated << " bytes iterated in total)" << std::endl;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const size_t number = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+	measure("Random words", dictionary_benchmark::generate_words(number));
+	measure("Inflected words", generate_inflections(number));
+
+	return 0;
+}
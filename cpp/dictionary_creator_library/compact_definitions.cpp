@@ -0,0 +1,323 @@
+#include "compact_definitions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+dictionary_creator::StringPool::~StringPool()
+{
+	for (auto &chunk: chunks)
+	{
+		delete[] chunk.load(std::memory_order_relaxed);
+	}
+}
+
+dictionary_creator::StringPool &dictionary_creator::StringPool::shared()
+{
+	static dictionary_creator::StringPool pool;
+	return pool;
+}
+
+dictionary_creator::StringPool &dictionary_creator::StringPool::shared_words()
+{
+	static dictionary_creator::StringPool pool;
+	return pool;
+}
+
+dictionary_creator::string_id dictionary_creator::StringPool::intern(std::string_view string)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (slots.empty())
+	{
+		slots.assign(1024, no_id);
+	}
+
+	auto slot = slot_of(string);
+
+	if (slots[slot] != no_id)
+	{
+		return slots[slot];
+	}
+
+	const auto id = strings.load(std::memory_order_relaxed);
+	if (id == no_id)
+	{
+		throw dictionary_creator::dictionary_runtime_error("string pool is out of ids");
+	}
+
+	const auto [chunk, offset] = locate(id);
+	auto *views = chunks[chunk].load(std::memory_order_relaxed);
+	if (views == nullptr)
+	{
+		views = new std::string_view[first_chunk_size << chunk];
+		chunks[chunk].store(views, std::memory_order_release);
+	}
+
+	views[offset] = store(string);
+	strings.store(id + 1, std::memory_order_release);
+	slots[slot] = id;
+
+	if (size_t{ id + 1 } * 4 > slots.size() * 3)
+	{
+		grow();
+	}
+
+	return id;
+}
+
+std::optional<dictionary_creator::string_id> dictionary_creator::StringPool::find(std::string_view string) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (slots.empty())
+	{
+		return std::nullopt;
+	}
+
+	const auto id = slots[slot_of(string)];
+	if (id == no_id)
+	{
+		return std::nullopt;
+	}
+
+	return id;
+}
+
+std::string_view dictionary_creator::StringPool::view(dictionary_creator::string_id id) const
+{
+	// the acquire pairs with the release of intern(), the view and its chunk are written by then
+	if (id >= strings.load(std::memory_order_acquire))
+	{
+		throw std::out_of_range("string pool has no such id");
+	}
+
+	return stored(id);
+}
+
+size_t dictionary_creator::StringPool::size() const
+{
+	return strings.load(std::memory_order_acquire);
+}
+
+std::pair<size_t, size_t> dictionary_creator::StringPool::locate(dictionary_creator::string_id id) noexcept
+{
+	// chunk k holds first_chunk_size << k views and starts after the (2^k - 1) * first_chunk_size ids before it
+	const size_t blocks = id / first_chunk_size + 1;
+
+	size_t chunk = 0;
+	while ((blocks >> (chunk + 1)) != 0)
+	{
+		++chunk;
+	}
+
+	return { chunk, id - ((size_t{ 1 } << chunk) - 1) * first_chunk_size };
+}
+
+std::string_view dictionary_creator::StringPool::stored(dictionary_creator::string_id id) const noexcept
+{
+	const auto [chunk, offset] = locate(id);
+
+	return chunks[chunk].load(std::memory_order_acquire)[offset];
+}
+
+size_t dictionary_creator::StringPool::memory_usage() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	size_t views_bytes = 0;
+	for (size_t chunk = 0; chunk != chunk_count; ++chunk)
+	{
+		if (chunks[chunk].load(std::memory_order_relaxed) != nullptr)
+		{
+			views_bytes += (first_chunk_size << chunk) * sizeof(std::string_view);
+		}
+	}
+
+	return blocks_bytes
+		+ blocks.capacity() * sizeof(std::unique_ptr<char[]>)
+		+ views_bytes
+		+ slots.capacity() * sizeof(dictionary_creator::string_id);
+}
+
+std::string_view dictionary_creator::StringPool::store(std::string_view string)
+{
+	if (string.empty())
+	{
+		return {};
+	}
+
+	// long strings get a block of their own, so that the current one isn't abandoned half empty
+	if (string.size() > block_size / 4)
+	{
+		blocks.push_back(std::make_unique<char[]>(string.size()));
+		blocks_bytes += string.size();
+		std::memcpy(blocks.back().get(), string.data(), string.size());
+
+		return { blocks.back().get(), string.size() };
+	}
+
+	if (string.size() > block_free)
+	{
+		blocks.push_back(std::make_unique<char[]>(block_size));
+		blocks_bytes += block_size;
+		current_block = blocks.back().get();
+		block_free = block_size;
+	}
+
+	char *destination = current_block;
+	std::memcpy(destination, string.data(), string.size());
+	current_block += string.size();
+	block_free -= string.size();
+
+	return { destination, string.size() };
+}
+
+size_t dictionary_creator::StringPool::slot_of(std::string_view string) const noexcept
+{
+	const size_t mask = slots.size() - 1;
+
+	size_t slot = std::hash<std::string_view>{}(string) & mask;
+	while (slots[slot] != no_id && stored(slots[slot]) != string)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
+}
+
+void dictionary_creator::StringPool::grow()
+{
+	slots.assign(slots.size() * 2, no_id);
+
+	const size_t mask = slots.size() - 1;
+
+	const auto count = strings.load(std::memory_order_relaxed);
+	for (dictionary_creator::string_id id = 0; id != count; ++id)
+	{
+		size_t slot = std::hash<std::string_view>{}(stored(id)) & mask;
+		while (slots[slot] != no_id)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		slots[slot] = id;
+	}
+}
+
+dictionary_creator::CompactDefinitions::CompactDefinitions(const dictionary_creator::definitions_t &definitions)
+{
+	size_t total = 0;
+	for (const auto &[part_of_speech, part_meanings]: definitions)
+	{
+		total += std::max<size_t>(part_meanings.size(), 1);
+	}
+
+	if (total == 0)
+	{
+		return;
+	}
+
+	if (total > std::numeric_limits<uint32_t>::max())
+	{
+		throw dictionary_creator::dictionary_runtime_error("too many definitions for a single entry");
+	}
+
+	auto &pool = dictionary_creator::StringPool::shared();
+
+	items = std::make_unique<dictionary_creator::Definition[]>(total);
+	count = static_cast<uint32_t>(total);
+
+	size_t i = 0;
+	for (const auto &[part_of_speech, part_meanings]: definitions)
+	{
+		const auto part_id = pool.intern(part_of_speech);
+
+		if (part_meanings.empty())
+		{
+			items[i++] = { part_id, no_meaning };
+		}
+
+		for (const auto &meaning: part_meanings)
+		{
+			items[i++] = { part_id, pool.intern(meaning) };
+		}
+
+		meanings += static_cast<uint32_t>(part_meanings.size());
+	}
+}
+
+dictionary_creator::CompactDefinitions::CompactDefinitions(const dictionary_creator::CompactDefinitions &other)
+	: items{ other.count != 0 ? std::make_unique<dictionary_creator::Definition[]>(other.count) : nullptr }, count{ other.count },
+	meanings{ other.meanings }
+{
+	std::copy(other.begin(), other.end(), items.get());
+}
+
+dictionary_creator::CompactDefinitions &dictionary_creator::CompactDefinitions::operator=(const dictionary_creator::CompactDefinitions &other)
+{
+	if (this != &other)
+	{
+		*this = dictionary_creator::CompactDefinitions(other);
+	}
+
+	return *this;
+}
+
+dictionary_creator::definitions_t dictionary_creator::CompactDefinitions::expand() const
+{
+	dictionary_creator::definitions_t result;
+
+	auto part = result.end();
+	for (const auto &definition: *this)
+	{
+		if (part == result.end() || part->first != text(definition.part_of_speech))
+		{
+			part = result.emplace_hint(result.end(), text(definition.part_of_speech), std::set<dictionary_creator::utf8_string>{});
+		}
+
+		if (definition.meaning != no_meaning)
+		{
+			part->second.emplace_hint(part->second.end(), text(definition.meaning));
+		}
+	}
+
+	return result;
+}
+
+const dictionary_creator::Definition *dictionary_creator::CompactDefinitions::begin() const noexcept
+{
+	return items.get();
+}
+
+const dictionary_creator::Definition *dictionary_creator::CompactDefinitions::end() const noexcept
+{
+	return items.get() + count;
+}
+
+size_t dictionary_creator::CompactDefinitions::size() const noexcept
+{
+	return count;
+}
+
+bool dictionary_creator::CompactDefinitions::empty() const noexcept
+{
+	return count == 0;
+}
+
+size_t dictionary_creator::CompactDefinitions::count_meanings() const noexcept
+{
+	return meanings;
+}
+
+std::string_view dictionary_creator::CompactDefinitions::text(dictionary_creator::string_id id)
+{
+	return dictionary_creator::StringPool::shared().view(id);
+}
+
+size_t dictionary_creator::CompactDefinitions::memory_usage() const noexcept
+{
+	return count * sizeof(dictionary_creator::Definition);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "dictionary_types.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Definitions of an Entry in a compact form.
+//
+// 	-- every distinct part of speech and meaning is stored once, in a process-wide StringPool, and referred to by a 32-bit id
+// 	-- an entry keeps a single array of (part of speech, meaning) id pairs, in the order definitions_t iterates them;
+// 	   a part of speech without meanings keeps a pair of its own with no_meaning, so that it still defines the entry
+// 	-- the pools are process-wide and only grow: destroying a dictionary, or the memory resource it was given,
+// 	   never returns the text of its definitions, strings stay interned until the process ends
+// 	-- pooled bytes belong to no dictionary, they are reported by StringPool::memory_usage() and left out of Dictionary::memory_usage()
+// 	-- words of interned dictionaries get a pool of their own, shared_words(), so that their ids stay dense
+// 	-- view() takes no lock: strings and the chunks of views pointing at them never move once written,
+// 	   only interning and lookups by text take the mutex
+// 	-- definitions_t remains the format exchanged with definers and archives; Entry::get_definitions() assembles one
+// 	   by value on every call, loops over many entries should walk get_compact_definitions() instead
+
+namespace dictionary_creator
+{
+	using string_id = uint32_t;
+
+	class StringPool
+	{
+	public:
+		StringPool() = default;
+		~StringPool();
+
+		static StringPool &shared();
+		static StringPool &shared_words();
+
+		string_id intern(std::string_view string);
+		// the id of a string interned already, without interning it
+		std::optional<string_id> find(std::string_view string) const;
+		// throws std::out_of_range for an id the pool hasn't given out
+		std::string_view view(string_id id) const;
+
+		size_t size() const;
+		size_t memory_usage() const;
+
+	private:
+		static constexpr size_t block_size = 64 * 1024;
+
+		mutable std::mutex mutex;
+		std::vector<std::unique_ptr<char[]>> blocks;
+		char *current_block = nullptr;
+		size_t block_free = 0;
+		size_t blocks_bytes = 0;
+
+		// views of the strings by id, in chunks doubling in size, each allocated once and published before its ids are
+		static constexpr size_t first_chunk_size = 1024;
+		static constexpr size_t chunk_count = 32;
+		std::array<std::atomic<std::string_view *>, chunk_count> chunks{};
+		std::atomic<string_id> strings{ 0 };
+
+		// open addressing table of ids, no_id marks a free slot
+		static constexpr string_id no_id = static_cast<string_id>(-1);
+		std::vector<string_id> slots;
+
+		static std::pair<size_t, size_t> locate(string_id id) noexcept;
+		std::string_view stored(string_id id) const noexcept;
+		std::string_view store(std::string_view string);
+		size_t slot_of(std::string_view string) const noexcept;
+		void grow();
+	};
+
+	struct Definition
+	{
+		string_id part_of_speech;
+		string_id meaning;
+	};
+
+	class CompactDefinitions
+	{
+	public:
+		CompactDefinitions() noexcept = default;
+		explicit CompactDefinitions(const definitions_t &definitions);
+
+		CompactDefinitions(const CompactDefinitions &other);
+		CompactDefinitions(CompactDefinitions &&other) noexcept = default;
+		CompactDefinitions &operator=(const CompactDefinitions &other);
+		CompactDefinitions &operator=(CompactDefinitions &&other) noexcept = default;
+
+		// the meaning of the pair kept for a part of speech that has none
+		static constexpr string_id no_meaning = static_cast<string_id>(-1);
+
+		definitions_t expand() const;
+
+		const Definition *begin() const noexcept;
+		const Definition *end() const noexcept;
+		size_t size() const noexcept;
+		bool empty() const noexcept;
+		// pairs that have a meaning, those without one don't count
+		size_t count_meanings() const noexcept;
+
+		static std::string_view text(string_id id);
+
+		// heap bytes of the array, the pooled strings are reported by StringPool::memory_usage()
+		size_t memory_usage() const noexcept;
+
+	private:
+		std::unique_ptr<Definition[]> items;
+		uint32_t count = 0;
+		uint32_t meanings = 0;
+	};
+}
@@ -0,0 +1,231 @@
+#include "definitions_section.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace
+{
+	void write_number(std::ostream &stream, uint32_t number)
+	{
+		const std::array<char, 4> bytes = {
+			static_cast<char>(number & 0xFF),
+			static_cast<char>((number >> 8) & 0xFF),
+			static_cast<char>((number >> 16) & 0xFF),
+			static_cast<char>((number >> 24) & 0xFF)
+		};
+		stream.write(bytes.data(), bytes.size());
+	}
+
+	void write_size(std::ostream &stream, size_t size)
+	{
+		if (size > std::numeric_limits<uint32_t>::max())
+		{
+			throw dictionary_creator::dictionary_runtime_error("definitions are too large for a definitions section");
+		}
+		write_number(stream, static_cast<uint32_t>(size));
+	}
+
+	void write_string(std::ostream &stream, const dictionary_creator::utf8_string &string)
+	{
+		write_size(stream, string.size());
+		stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+	}
+
+	uint32_t read_number(std::istream &stream)
+	{
+		std::array<unsigned char, 4> bytes{};
+		if (!stream.read(reinterpret_cast<char *>(bytes.data()), bytes.size()))
+		{
+			throw dictionary_creator::dictionary_runtime_error("definitions section is damaged");
+		}
+		return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+	}
+
+	dictionary_creator::utf8_string read_string(std::istream &stream)
+	{
+		dictionary_creator::utf8_string result(read_number(stream), '\0');
+		if (!stream.read(result.data(), static_cast<std::streamsize>(result.size())))
+		{
+			throw dictionary_creator::dictionary_runtime_error("definitions section is damaged");
+		}
+		return result;
+	}
+}
+
+std::shared_ptr<dictionary_creator::DefinitionsSection> dictionary_creator::DefinitionsSection::create(const std::filesystem::path &path)
+{
+	std::shared_ptr<dictionary_creator::DefinitionsSection> result(new dictionary_creator::DefinitionsSection);
+
+	result->path = path;
+	result->output.open(path, std::ios::binary | std::ios::trunc);
+	result->output.write(signature, sizeof(signature));
+
+	if (!result->output.good())
+	{
+		throw dictionary_creator::dictionary_runtime_error("couldn't write the definitions section");
+	}
+
+	return result;
+}
+
+std::shared_ptr<dictionary_creator::DefinitionsSection> dictionary_creator::DefinitionsSection::open(const std::filesystem::path &path, size_t resident_limit)
+{
+	std::shared_ptr<dictionary_creator::DefinitionsSection> result(new dictionary_creator::DefinitionsSection);
+
+	// the definitions just read have to stay until they are returned
+	result->resident_limit = std::max<size_t>(resident_limit, 1);
+	result->path = path;
+	result->open_input();
+
+	return result;
+}
+
+dictionary_creator::DefinitionsSection::record_type dictionary_creator::DefinitionsSection::append(const dictionary_creator::definitions_t &definitions)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (!output.is_open())
+	{
+		throw dictionary_creator::dictionary_runtime_error("definitions section isn't open for writing");
+	}
+
+	const auto record = static_cast<dictionary_creator::DefinitionsSection::record_type>(output.tellp());
+
+	write_size(output, definitions.size());
+	for (const auto &[part_of_speech, meanings]: definitions)
+	{
+		write_string(output, part_of_speech);
+		write_size(output, meanings.size());
+		for (const auto &meaning: meanings)
+		{
+			write_string(output, meaning);
+		}
+	}
+
+	if (!output.good())
+	{
+		throw dictionary_creator::dictionary_runtime_error("couldn't write the definitions section");
+	}
+
+	return record;
+}
+
+void dictionary_creator::DefinitionsSection::finish()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	output.close();
+	if (output.fail())
+	{
+		throw dictionary_creator::dictionary_runtime_error("couldn't write the definitions section");
+	}
+}
+
+dictionary_creator::definitions_t dictionary_creator::DefinitionsSection::read(dictionary_creator::DefinitionsSection::record_type record)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (auto found = cached.find(record); found != cached.end())
+	{
+		recent.splice(recent.begin(), recent, found->second);
+		return found->second->second;
+	}
+
+	recent.emplace_front(record, decode(record));
+	cached.emplace(record, recent.begin());
+
+	while (recent.size() > resident_limit)
+	{
+		cached.erase(recent.back().first);
+		recent.pop_back();
+	}
+
+	return recent.front().second;
+}
+
+size_t dictionary_creator::DefinitionsSection::resident() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return recent.size();
+}
+
+const std::filesystem::path &dictionary_creator::DefinitionsSection::get_path() const noexcept
+{
+	return path;
+}
+
+void dictionary_creator::DefinitionsSection::release()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	input.close();
+}
+
+void dictionary_creator::DefinitionsSection::reopen()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	open_input();
+}
+
+void dictionary_creator::DefinitionsSection::relocate(const std::filesystem::path &new_path,
+	std::unordered_map<dictionary_creator::DefinitionsSection::record_type, dictionary_creator::DefinitionsSection::record_type> moved)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// the definitions cached are the same wherever their records are
+	path = new_path;
+	moved_records = std::move(moved);
+	open_input();
+}
+
+void dictionary_creator::DefinitionsSection::open_input()
+{
+	input.close();
+	input.clear();
+	input.open(path, std::ios::binary);
+
+	char read_signature[sizeof(signature)] = {};
+	if (!input.read(read_signature, sizeof(read_signature)) || !std::equal(std::begin(signature), std::end(signature), read_signature))
+	{
+		input.close();
+		throw dictionary_creator::dictionary_runtime_error("not a definitions section");
+	}
+}
+
+dictionary_creator::definitions_t dictionary_creator::DefinitionsSection::decode(dictionary_creator::DefinitionsSection::record_type record)
+{
+	if (!input.is_open())
+	{
+		throw dictionary_creator::dictionary_runtime_error("definitions section isn't open for reading");
+	}
+
+	if (moved_records)
+	{
+		const auto found = moved_records->find(record);
+		if (found == moved_records->end())
+		{
+			throw dictionary_creator::dictionary_runtime_error("definitions are no longer in their section");
+		}
+
+		record = found->second;
+	}
+
+	input.clear();
+	input.seekg(static_cast<std::streamoff>(record));
+
+	dictionary_creator::definitions_t result;
+
+	for (auto parts = read_number(input); parts != 0; --parts)
+	{
+		auto &meanings = result[read_string(input)];
+		for (auto count = read_number(input); count != 0; --count)
+		{
+			meanings.insert(meanings.end(), read_string(input));
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "dictionary_types.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// File holding the definitions of saved entries apart from the dictionary archive.
+//
+// 	-- a section is either being written (create(), append(), finish()) or read (open(), read()), never both
+// 	-- every entry's definitions make one record, the archive keeps only its offset and the number of definitions
+// 	-- records are read from the file the first time they are asked for, at most resident_limit of them stay decoded in memory,
+// 	   the least recently read one is dropped first
+// 	-- text read from a section doesn't enter the StringPool, so memory stays bounded by the limit rather than by the definitions read so far
+// 	-- release() and relocate() let a section follow its records into a file written to replace the one it reads,
+// 	   the file is closed meanwhile, so that it can be replaced where open files can't be
+// 	-- the records are little-endian, a 32-bit count or length precedes every set, map and string
+
+namespace dictionary_creator
+{
+	enum class DefinitionsStorage
+	{
+		Inline,
+		Apart
+	};
+
+	class DefinitionsSection
+	{
+	public:
+		using record_type = uint64_t;
+
+		static constexpr size_t default_resident_limit = 1024;
+
+		static std::shared_ptr<DefinitionsSection> create(const std::filesystem::path &path);
+		static std::shared_ptr<DefinitionsSection> open(const std::filesystem::path &path, size_t resident_limit = default_resident_limit);
+
+		record_type append(const definitions_t &definitions);
+		void finish();
+
+		definitions_t read(record_type record);
+		size_t resident() const;
+
+		const std::filesystem::path &get_path() const noexcept;
+		// closes the file until reopen() or relocate(), records can't be read meanwhile
+		void release();
+		void reopen();
+		// the records read before are to be found in the file at path under the records moved gives them,
+		// the ones it doesn't mention are gone
+		void relocate(const std::filesystem::path &path, std::unordered_map<record_type, record_type> moved);
+
+		DefinitionsSection(const DefinitionsSection &) = delete;
+		DefinitionsSection &operator=(const DefinitionsSection &) = delete;
+
+	private:
+		DefinitionsSection() = default;
+
+		static constexpr char signature[8] = { 'D', 'C', 'D', 'E', 'F', 'S', '0', '1' };
+
+		mutable std::mutex mutex;
+		std::filesystem::path path;
+		std::ofstream output;
+		std::ifstream input;
+		// records as entries know them to records of the file they have moved to, empty until relocate()
+		std::optional<std::unordered_map<record_type, record_type>> moved_records;
+
+		size_t resident_limit = default_resident_limit;
+		std::list<std::pair<record_type, definitions_t>> recent;
+		std::unordered_map<record_type, decltype(recent)::iterator> cached;
+
+		definitions_t decode(record_type record);
+		void open_input();
+	};
+
+	// where the definitions of an Entry kept apart are to be found
+	struct DefinitionsLocation
+	{
+		std::shared_ptr<DefinitionsSection> section;
+		DefinitionsSection::record_type record;
+		uint32_t count;
+	};
+
+	// boost archive helper carrying the section entries are written to or read from,
+	// to be looked up as get_helper<DefinitionsArchiveHelper>(DefinitionsArchiveHelper::key());
+	// without one an archive keeps the definitions inline
+	struct DefinitionsArchiveHelper
+	{
+		std::shared_ptr<DefinitionsSection> section;
+
+		// entries that were kept apart before: the section they were read from, their record there and the one written
+		struct Moved
+		{
+			std::shared_ptr<DefinitionsSection> from;
+			DefinitionsSection::record_type record;
+			DefinitionsSection::record_type written;
+		};
+
+		std::vector<Moved> moved;
+
+		// the default key of archive helpers is taken by the one of std::shared_ptr
+		static void *key() noexcept
+		{
+			static char unique;
+			return &unique;
+		}
+	};
+}
@@ -2,29 +2,227 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+namespace
+{
+	constexpr size_t tree_node_overhead = 4 * sizeof(void *);
+	constexpr size_t list_node_overhead = 2 * sizeof(void *);
+	constexpr size_t control_block_overhead = 2 * sizeof(long) + sizeof(void *);
+
+	// get_top() of a smaller dictionary doesn't hand its letters out to a pool
+	constexpr size_t parallel_top_words = 1 << 15;
+
+	size_t string_heap_bytes(size_t length) noexcept
+	{
+		static const size_t sso_capacity = dictionary_creator::utf8_string{}.capacity();
+
+		return length > sso_capacity ? length + 1 : 0;
+	}
+
+	size_t depth_of(size_t size) noexcept
+	{
+		size_t depth = 1;
+		while ((size >> depth) != 0)
+		{
+			++depth;
+		}
+
+		return depth;
+	}
+
+	// walking costs a step for every entry of both buckets, a lookup about log2 steps of the searched bucket for every walked entry
+	bool prefers_lookups(size_t walked, size_t searched) noexcept
+	{
+		return walked * depth_of(searched) < walked + searched;
+	}
+
+	size_t walk_cost(size_t walked, size_t searched) noexcept
+	{
+		return std::min(walked + searched, walked * depth_of(searched));
+	}
+
+	// the first entry of the bucket not sorted before the given one, stepping on from the position of the previous one
+	dictionary_creator::Dictionary::bucket_type::const_iterator seek(const dictionary_creator::Dictionary::bucket_type &bucket,
+		dictionary_creator::Dictionary::bucket_type::const_iterator position, const std::shared_ptr<dictionary_creator::Entry> &entry, bool lookup)
+	{
+		if (lookup)
+		{
+			return bucket.lower_bound(entry);
+		}
+
+		const dictionary_creator::DefaultEntrySorter less;
+		while (position != bucket.end() && less(*position, entry))
+		{
+			++position;
+		}
+
+		return position;
+	}
+
+	// walks two buckets in their common order: only_own and only_theirs get the entries the other bucket lacks,
+	// both gets the two entries of a word they have in common
+	template <typename OnlyOwn, typename OnlyTheirs, typename Both>
+	void join_buckets(const dictionary_creator::Dictionary::bucket_type &own, const dictionary_creator::Dictionary::bucket_type &theirs,
+		OnlyOwn &&only_own, OnlyTheirs &&only_theirs, Both &&both)
+	{
+		const dictionary_creator::DefaultEntrySorter less;
+
+		auto mine = own.begin();
+		auto others = theirs.begin();
+
+		while (mine != own.end() || others != theirs.end())
+		{
+			if (others == theirs.end() || (mine != own.end() && less(*mine, *others)))
+			{
+				only_own(*mine++);
+			}
+			else if (mine == own.end() || less(*others, *mine))
+			{
+				only_theirs(*others++);
+			}
+			else
+			{
+				both(*mine++, *others++);
+			}
+		}
+	}
+
+	// visits the buckets of every letter either of the dictionaries has, a letter one of them lacks comes with an empty bucket
+	template <typename Visit>
+	void join_letters(const dictionary_creator::Dictionary::default_dictionary_type &own, const dictionary_creator::Dictionary::default_dictionary_type &theirs,
+		Visit &&visit)
+	{
+		static const dictionary_creator::Dictionary::bucket_type nothing;
+
+		for (const auto &[letter, entries]: own)
+		{
+			const auto found = theirs.find(letter);
+			visit(entries, found != theirs.end() ? found->second : nothing);
+		}
+
+		for (const auto &[letter, entries]: theirs)
+		{
+			if (own.find(letter) == own.end())
+			{
+				visit(nothing, entries);
+			}
+		}
+	}
+
+	double counters_sum(const dictionary_creator::Dictionary::default_dictionary_type &dictionary)
+	{
+		double sum = 0.0;
+		for (const auto &[letter, entries]: dictionary)
+		{
+			for (const auto &entry: entries)
+			{
+				sum += static_cast<double>(entry->get_counter());
+			}
+		}
+
+		return sum;
+	}
+
+	// a word met `own` times out of `own_total` here and `theirs` times out of `theirs_total` in the reference
+	double keyness_score(dictionary_creator::KeynessMeasure measure, double own, double theirs, double own_total, double theirs_total)
+	{
+		const double total = own_total + theirs_total;
+		const double word_total = own + theirs;
+
+		if (measure == dictionary_creator::KeynessMeasure::ChiSquare)
+		{
+			const double rest = total - word_total;
+			const double cross = own * (theirs_total - theirs) - theirs * (own_total - own);
+
+			return rest > 0.0 ? total * cross * cross / (word_total * rest * own_total * theirs_total) : 0.0;
+		}
+
+		// the word and the rest of the words on either side, each cell against the count it would have without any difference
+		auto cell = [total] (double observed, double side_total, double row_total)
+			{
+				return observed > 0.0 ? observed * std::log(observed * total / (side_total * row_total)) : 0.0;
+			};
+
+		const double rest = total - word_total;
+		const double score = cell(own, own_total, word_total) + cell(theirs, theirs_total, word_total)
+			+ cell(own_total - own, own_total, rest) + cell(theirs_total - theirs, theirs_total, rest);
+
+		return 2.0 * score;
+	}
+}
+
+size_t dictionary_creator::MemoryUsage::total() const noexcept
+{
+	return word_strings + entries + definitions + proper_nouns + container_nodes;
+}
+
+dictionary_creator::MemoryUsage &dictionary_creator::MemoryUsage::operator+=(const dictionary_creator::MemoryUsage &other) noexcept
+{
+	word_strings += other.word_strings;
+	entries += other.entries;
+	definitions += other.definitions;
+	proper_nouns += other.proper_nouns;
+	container_nodes += other.container_nodes;
+
+	return *this;
+}
+
+bool dictionary_creator::DictionaryDelta::empty() const noexcept
+{
+	return added.empty() && removed.empty() && counters.empty() && defined.empty() && added_proper_nouns.empty() && removed_proper_nouns.empty();
+}
+
+dictionary_creator::CollatedWord::CollatedWord(dictionary_creator::utf8_string word)
+	: sort_key{ collation_key(word) }, word{ std::move(word) }
+{}
 
 bool dictionary_creator::DefaultEntrySorter::operator()
 	(const std::shared_ptr<dictionary_creator::Entry> &a, const std::shared_ptr<dictionary_creator::Entry> &b) const noexcept
 {
-	return a->get_word() < b->get_word();
+	if (int order = a->get_sort_key().compare(b->get_sort_key()); order != 0)
+	{
+		return order < 0;
+	}
+	return std::strcmp(*a, *b) < 0;
+}
+
+bool dictionary_creator::DefaultEntrySorter::operator()
+	(const std::shared_ptr<dictionary_creator::Entry> &a, const dictionary_creator::CollatedWord &b) const noexcept
+{
+	if (int order = a->get_sort_key().compare(b.sort_key); order != 0)
+	{
+		return order < 0;
+	}
+	return b.word.compare(*a) > 0;
+}
+
+bool dictionary_creator::DefaultEntrySorter::operator()
+	(const dictionary_creator::CollatedWord &a, const std::shared_ptr<dictionary_creator::Entry> &b) const noexcept
+{
+	if (int order = a.sort_key.compare(b->get_sort_key()); order != 0)
+	{
+		return order < 0;
+	}
+	return a.word.compare(*b) < 0;
 }
 
 bool dictionary_creator::DefaultEntrySorter::operator()
-	(const std::shared_ptr<dictionary_creator::Entry> &a, const dictionary_creator::utf8_string &b) const noexcept
+	(const std::shared_ptr<dictionary_creator::Entry> &a, const dictionary_creator::utf8_string &b) const
 {
-	return a->get_word() < b;
+	return (*this)(a, dictionary_creator::CollatedWord{ b });
 }
 
 bool dictionary_creator::DefaultEntrySorter::operator()
-	(const dictionary_creator::utf8_string &a, const std::shared_ptr<dictionary_creator::Entry> &b) const noexcept
+	(const dictionary_creator::utf8_string &a, const std::shared_ptr<dictionary_creator::Entry> &b) const
 {
-	return a < b->get_word();
+	return (*this)(dictionary_creator::CollatedWord{ a }, b);
 }
 
-dictionary_creator::Dictionary::Dictionary(dictionary_creator::Language language) :
-	language{ language },
-	dictionary{ supported_locales[static_cast<size_t>(language)]},
-	proper_nouns{ supported_locales[static_cast<size_t>(language)]}
+dictionary_creator::Dictionary::Dictionary(dictionary_creator::Language language, std::pmr::memory_resource *resource) :
+	language{ language }, resource{ resource }, dictionary{ bucket_type(resource) }, proper_nouns{ bucket_type(resource) }
 {}
 
 dictionary_creator::Dictionary &dictionary_creator::Dictionary::merge(const dictionary_creator::Dictionary &other)
@@ -36,376 +234,1661 @@ dictionary_creator::Dictionary &dictionary_creator::Dictionary::merge(const dict
 	
 	for (const auto &[letter, entries]: other.dictionary)
 	{
-		for (const auto &entry: entries)
+		merge_bucket(dictionary[letter], entries, other);
+	}
+
+	take_proper_nouns(other);
+
+	return *this;
+}
+
+dictionary_creator::Dictionary &dictionary_creator::Dictionary::merge(const dictionary_creator::Dictionary &other, dictionary_creator::ThreadPool &pool)
+{
+	if (language != other.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to merge language mismatching dictionaries");
+	}
+
+	// buckets are looked up beforehand, the letter map itself is never changed concurrently
+	std::vector<std::pair<bucket_type *, const bucket_type *>> buckets;
+	std::vector<size_t> weights;
+
+	for (const auto &[letter, entries]: other.dictionary)
+	{
+		auto &own_entries = dictionary[letter];
+		buckets.emplace_back(&own_entries, &entries);
+		weights.push_back(walk_cost(entries.size(), own_entries.size()));
+	}
+
+	std::vector<dictionary_creator::Dictionary::BucketChanges> changes(buckets.size());
+
+	try
+	{
+		pool.run(weights, [&] (size_t i) { merge_bucket(*buckets[i].first, *buckets[i].second, other, &changes[i]); });
+	}
+	catch (...)
+	{
+		catch_up(changes);
+		throw;
+	}
+
+	catch_up(changes);
+	take_proper_nouns(other);
+
+	return *this;
+}
+
+dictionary_creator::Dictionary &dictionary_creator::Dictionary::merge(dictionary_creator::Dictionary &&other)
+{
+	if (language != other.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to merge language mismatching dictionaries");
+	}
+
+	// nothing allocated by another resource is taken over
+	if (*other.resource != *resource)
+	{
+		return merge(static_cast<const dictionary_creator::Dictionary &>(other));
+	}
+
+	const bool track_moved_entries = prefix_index || fuzzy_index || word_filter || word_sketch || !proper_nouns.empty();
+
+	for (auto &[letter, entries]: other.dictionary)
+	{
+		auto &own_entries = dictionary[letter];
+
+		// a letter new to this dictionary takes the whole bucket over
+		if (own_entries.empty())
 		{
-			if (auto existing = dictionary[letter].find(entry); existing != dictionary[letter].end())
+			if (track_moved_entries)
 			{
-				(*existing)->increment_counter(entry->get_counter());
+				for (const auto &entry: entries)
+				{
+					register_entry(entry);
+					track_new_word(entry);
+				}
 			}
-			else
+
+			own_entries.merge(std::move(entries));
+		}
+		else
+		{
+			merge_bucket(own_entries, entries, other);
+		}
+	}
+	
+	take_proper_nouns(std::move(other));
+
+	return *this;
+}
+
+dictionary_creator::Dictionary &dictionary_creator::Dictionary::subtract(const dictionary_creator::Dictionary &other)
+{
+	if (language != other.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to subtract language mismatching dictionaries");
+	}
+
+	if (&other != this)
+	{
+		for (const auto &[letter, entries]: other.dictionary)
+		{
+			if (auto own_entries = dictionary.find(letter); own_entries != dictionary.end())
 			{
-				dictionary[letter].insert(entry);
+				subtract_bucket(own_entries->second, entries);
 			}
 		}
+
+		take_proper_nouns(other);
+	}
+	else
+	{
+		clear_words();
 	}
 
-	for (const auto &[letter, entries]: other.proper_nouns)
+	return *this;
+}
+
+dictionary_creator::Dictionary &dictionary_creator::Dictionary::subtract(const dictionary_creator::Dictionary &other, dictionary_creator::ThreadPool &pool)
+{
+	if (language != other.language)
 	{
-		for (const auto &entry: entries)
+		throw dictionary_creator::dictionary_runtime_error("an attempt to subtract language mismatching dictionaries");
+	}
+
+	if (&other == this)
+	{
+		return subtract(other);
+	}
+
+	std::vector<std::pair<bucket_type *, const bucket_type *>> buckets;
+	std::vector<size_t> weights;
+
+	for (const auto &[letter, entries]: other.dictionary)
+	{
+		if (auto own_entries = dictionary.find(letter); own_entries != dictionary.end())
 		{
-			proper_nouns[letter].insert(entry);
+			buckets.emplace_back(&own_entries->second, &entries);
+			weights.push_back(walk_cost(entries.size(), own_entries->second.size()));
 		}
 	}
 
-	remove_proper_nouns();
+	std::vector<dictionary_creator::Dictionary::BucketChanges> changes(buckets.size());
+
+	try
+	{
+		pool.run(weights, [&] (size_t i) { subtract_bucket(*buckets[i].first, *buckets[i].second, &changes[i]); });
+	}
+	catch (...)
+	{
+		catch_up(changes);
+		throw;
+	}
+
+	catch_up(changes);
+	take_proper_nouns(other);
 
 	return *this;
 }
 
-dictionary_creator::Dictionary &dictionary_creator::Dictionary::merge(dictionary_creator::Dictionary &&other)
+dictionary_creator::Dictionary &dictionary_creator::Dictionary::subtract(dictionary_creator::Dictionary &&other)
 {
 	if (language != other.language)
 	{
-		throw dictionary_creator::dictionary_runtime_error("an attempt to merge language mismatching dictionaries");
+		throw dictionary_creator::dictionary_runtime_error("an attempt to subtract language mismatching dictionaries");
 	}
 
-	for (auto &[letter, entries]: other.dictionary)
+	if (*other.resource != *resource)
+	{
+		return subtract(static_cast<const dictionary_creator::Dictionary &>(other));
+	}
+
+	if (&other != this)
 	{
-		for (auto &entry: entries)
+		for (const auto &[letter, entries]: other.dictionary)
 		{
-			if (auto existing = dictionary[letter].find(entry); existing != dictionary[letter].end())
+			if (auto own_entries = dictionary.find(letter); own_entries != dictionary.end())
 			{
-				(*existing)->increment_counter(entry->get_counter());
+				subtract_bucket(own_entries->second, entries);
 			}
 		}
-		dictionary[letter].merge(std::move(other.dictionary[letter]));
+
+		take_proper_nouns(std::move(other));
 	}
-	
-	for (auto &[letter, entries]: other.proper_nouns)
+	else
 	{
-		proper_nouns[std::move(letter)].merge(std::move(entries));
+		clear_words();
 	}
 
-	remove_proper_nouns();
-
 	return *this;
 }
 
-dictionary_creator::Dictionary &dictionary_creator::Dictionary::subtract(const dictionary_creator::Dictionary &other)
+dictionary_creator::Dictionary dictionary_creator::Dictionary::intersection_with(const dictionary_creator::Dictionary &other) const
 {
 	if (language != other.language)
 	{
-		throw dictionary_creator::dictionary_runtime_error("an attempt to subtract language mismatching dictionaries");
+		throw dictionary_creator::dictionary_runtime_error("an attempt to find intersection of lanugage mismatching dictionaries");
 	}
 
-	if (&other != this)
+	dictionary_creator::Dictionary result(language, resource);
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		if (auto others = other.dictionary.find(letter); others != other.dictionary.end())
+		{
+			if (auto common = intersect_bucket(entries, others->second, other); !common.empty())
+			{
+				result.dictionary[letter] = std::move(common);
+			}
+		}
+	}
+
+	give_proper_nouns(result, other);
+
+	return result;
+}
+
+dictionary_creator::Dictionary dictionary_creator::Dictionary::intersection_with(const dictionary_creator::Dictionary &other, dictionary_creator::ThreadPool &pool) const
+{
+	if (language != other.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to find intersection of lanugage mismatching dictionaries");
+	}
+
+	std::vector<const dictionary_creator::letter_type *> letters;
+	std::vector<std::pair<const bucket_type *, const bucket_type *>> buckets;
+	std::vector<size_t> weights;
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		if (auto others = other.dictionary.find(letter); others != other.dictionary.end())
+		{
+			letters.push_back(&letter);
+			buckets.emplace_back(&entries, &others->second);
+			weights.push_back(walk_cost(std::min(entries.size(), others->second.size()), std::max(entries.size(), others->second.size())));
+		}
+	}
+
+	std::vector<bucket_type> commons(buckets.size(), bucket_type(resource));
+	pool.run(weights, [&] (size_t i) { commons[i] = intersect_bucket(*buckets[i].first, *buckets[i].second, other); });
+
+	dictionary_creator::Dictionary result(language, resource);
+
+	for (size_t i = 0; i != commons.size(); ++i)
+	{
+		if (!commons[i].empty())
+		{
+			result.dictionary[*letters[i]] = std::move(commons[i]);
+		}
+	}
+
+	give_proper_nouns(result, other);
+
+	return result;
+}
+
+dictionary_creator::DictionaryDelta dictionary_creator::Dictionary::diff(const dictionary_creator::Dictionary &other) const
+{
+	if (language != other.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to diff language mismatching dictionaries");
+	}
+
+	dictionary_creator::DictionaryDelta delta;
+	delta.language = other.language;
+
+	join_letters(dictionary, other.dictionary, [&delta] (const bucket_type &entries, const bucket_type &others)
+		{
+			if (entries.shares_contents_with(others))
+			{
+				return;
+			}
+
+			join_buckets(entries, others,
+				[&delta] (const std::shared_ptr<dictionary_creator::Entry> &entry) { delta.removed.push_back(entry->get_word()); },
+				[&delta] (const std::shared_ptr<dictionary_creator::Entry> &entry) { delta.added.push_back(entry); },
+				[&delta] (const std::shared_ptr<dictionary_creator::Entry> &own, const std::shared_ptr<dictionary_creator::Entry> &theirs)
+				{
+					if (own == theirs)
+					{
+						return;
+					}
+
+					if (!own->is_defined() && theirs->is_defined())
+					{
+						delta.defined.push_back(theirs);
+					}
+					else if (own->get_counter() != theirs->get_counter())
+					{
+						delta.counters.emplace_back(theirs->get_word(), theirs->get_counter());
+					}
+				});
+		});
+
+	join_letters(proper_nouns, other.proper_nouns, [&delta] (const bucket_type &entries, const bucket_type &others)
+		{
+			if (entries.shares_contents_with(others))
+			{
+				return;
+			}
+
+			join_buckets(entries, others,
+				[&delta] (const std::shared_ptr<dictionary_creator::Entry> &entry) { delta.removed_proper_nouns.push_back(entry->get_word()); },
+				[&delta] (const std::shared_ptr<dictionary_creator::Entry> &entry) { delta.added_proper_nouns.push_back(entry->get_word()); },
+				[] (const std::shared_ptr<dictionary_creator::Entry> &, const std::shared_ptr<dictionary_creator::Entry> &) {});
+		});
+
+	return delta;
+}
+
+dictionary_creator::Dictionary &dictionary_creator::Dictionary::apply(const dictionary_creator::DictionaryDelta &delta)
+{
+	if (language != delta.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to apply a delta of a language mismatching dictionary");
+	}
+
+	for (const auto &word: delta.removed)
+	{
+		remove_word(word);
+	}
+
+	for (const auto &entry: delta.added)
+	{
+		put_entry(entry);
+	}
+
+	for (const auto &entry: delta.defined)
+	{
+		put_entry(entry);
+	}
+
+	for (const auto &[word, counter]: delta.counters)
+	{
+		const auto letter = probe_first_letter(word);
+		const auto bucket = letter ? dictionary.find(*letter) : dictionary.end();
+
+		if (bucket == dictionary.end())
+		{
+			continue;
+		}
+
+		auto &entries = bucket->second;
+		if (auto found = entries.find(dictionary_creator::CollatedWord{ word }); found != entries.end() && (*found)->get_counter() != counter)
+		{
+			register_entry(*set_counter(entries, found, counter));
+		}
+	}
+
+	for (const auto &word: delta.removed_proper_nouns)
+	{
+		const auto letter = probe_first_letter(word);
+		const auto bucket = letter ? proper_nouns.find(*letter) : proper_nouns.end();
+
+		if (bucket == proper_nouns.end())
+		{
+			continue;
+		}
+
+		if (auto found = bucket->second.find(dictionary_creator::CollatedWord{ word }); found != bucket->second.end())
+		{
+			bucket->second.erase(found);
+		}
+	}
+
+	for (const auto &word: delta.added_proper_nouns)
+	{
+		add_proper_noun(word);
+	}
+
+	remove_proper_nouns();
+
+	return *this;
+}
+
+void dictionary_creator::Dictionary::put_entry(const std::shared_ptr<dictionary_creator::Entry> &entry)
+{
+	auto copy = typeid(*entry) == typeid(dictionary_creator::Entry) ? make_entry(*entry) : entry->clone();
+
+	// entries of derived types that can't be copied are shared, as adopt() has it
+	if (!copy)
+	{
+		copy = entry;
+	}
+
+	auto &entries = dictionary[get_first_letter(static_cast<const char *>(*copy))];
+
+	if (auto exists = entries.find(copy); exists != entries.end())
+	{
+		auto node = entries.extract(exists);
+		node.value() = std::move(copy);
+		register_entry(*entries.insert(std::move(node)).position);
+	}
+	else
+	{
+		auto position = entries.insert(std::move(copy)).first;
+		register_entry(*position);
+		track_new_word(*position);
+	}
+}
+
+std::vector<dictionary_creator::Keyword> dictionary_creator::Dictionary::keywords(const dictionary_creator::Dictionary &reference, size_t quantity,
+	dictionary_creator::KeynessMeasure measure) const
+{
+	if (language != reference.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error("an attempt to find keywords against a language mismatching dictionary");
+	}
+
+	const double own_total = counters_sum(dictionary);
+	const double theirs_total = counters_sum(reference.dictionary);
+
+	struct Candidate
+	{
+		double score;
+		size_t order;
+		size_t reference_counter;
+		const std::shared_ptr<dictionary_creator::Entry> *entry;
+	};
+
+	// the candidate kept worst of all sits on top of the heap, a later word loses a tie
+	auto better = [] (const Candidate &a, const Candidate &b) { return a.score > b.score || (a.score == b.score && a.order < b.order); };
+
+	std::vector<Candidate> heap;
+	heap.reserve(std::min(quantity, total_words()));
+
+	size_t order = 0;
+	auto consider = [&] (const std::shared_ptr<dictionary_creator::Entry> &entry, size_t theirs)
+		{
+			const double own = static_cast<double>(entry->get_counter());
+
+			// only words relatively more frequent here, own / own_total > theirs / theirs_total
+			if (quantity == 0 || own * theirs_total <= static_cast<double>(theirs) * own_total)
+			{
+				++order;
+				return;
+			}
+
+			const Candidate candidate{ keyness_score(measure, own, static_cast<double>(theirs), own_total, theirs_total), order++, theirs, &entry };
+
+			if (heap.size() < quantity)
+			{
+				heap.push_back(candidate);
+				std::push_heap(heap.begin(), heap.end(), better);
+			}
+			else if (better(candidate, heap.front()))
+			{
+				std::pop_heap(heap.begin(), heap.end(), better);
+				heap.back() = candidate;
+				std::push_heap(heap.begin(), heap.end(), better);
+			}
+		};
+
+	const dictionary_creator::DefaultEntrySorter less;
+
+	// letters only the reference has can't yield a keyword, they are summed up above and not walked again
+	for (const auto &[letter, entries]: dictionary)
+	{
+		const auto found = reference.dictionary.find(letter);
+		if (found == reference.dictionary.end())
+		{
+			for (const auto &entry: entries)
+			{
+				consider(entry, 0);
+			}
+			continue;
+		}
+
+		const auto &others = found->second;
+		const bool lookup = prefers_lookups(entries.size(), others.size());
+		auto position = others.begin();
+
+		for (const auto &entry: entries)
+		{
+			position = seek(others, position, entry, lookup);
+			consider(entry, position != others.end() && !less(entry, *position) ? (*position)->get_counter() : 0);
+		}
+	}
+
+	std::sort_heap(heap.begin(), heap.end(), better);
+
+	std::vector<dictionary_creator::Keyword> result;
+	result.reserve(heap.size());
+	for (const auto &candidate: heap)
+	{
+		result.push_back({ *candidate.entry, candidate.reference_counter, candidate.score });
+	}
+
+	return result;
+}
+
+dictionary_creator::Dictionary dictionary_creator::Dictionary::merge_all(const std::vector<const dictionary_creator::Dictionary *> &dictionaries,
+		std::pmr::memory_resource *resource)
+{
+	if (dictionaries.empty())
+	{
+		throw dictionary_creator::dictionary_runtime_error("no dictionaries to merge");
+	}
+
+	const auto language = dictionaries.front()->language;
+
+	std::map<dictionary_creator::letter_type, std::vector<std::pair<const bucket_type *, const dictionary_creator::Dictionary *>>> letters;
+
+	for (const auto *dictionary: dictionaries)
+	{
+		if (dictionary->language != language)
+		{
+			throw dictionary_creator::dictionary_runtime_error("an attempt to merge language mismatching dictionaries");
+		}
+
+		for (const auto &[letter, entries]: dictionary->dictionary)
+		{
+			if (!entries.empty())
+			{
+				letters[letter].emplace_back(&entries, dictionary);
+			}
+		}
+	}
+
+	dictionary_creator::Dictionary result(language, resource);
+
+	for (const auto &[letter, buckets]: letters)
+	{
+		if (buckets.size() == 1 && *buckets.front().second->resource == *resource)
+		{
+			result.dictionary[letter] = *buckets.front().first;
+		}
+		else
+		{
+			result.dictionary[letter] = result.merge_buckets(buckets);
+		}
+	}
+
+	for (const auto *dictionary: dictionaries)
+	{
+		for (const auto &[letter, entries]: dictionary->proper_nouns)
+		{
+			for (const auto &entry: entries)
+			{
+				result.proper_nouns[letter].insert(result.adopt(entry, *dictionary));
+			}
+		}
+	}
+
+	result.proper_nouns_rescan = true;
+	result.remove_proper_nouns();
+
+	return result;
+}
+
+dictionary_creator::Dictionary dictionary_creator::Dictionary::merge_all(const std::vector<dictionary_creator::Dictionary> &dictionaries,
+		std::pmr::memory_resource *resource)
+{
+	std::vector<const dictionary_creator::Dictionary *> pointers;
+	pointers.reserve(dictionaries.size());
+
+	for (const auto &dictionary: dictionaries)
+	{
+		pointers.push_back(&dictionary);
+	}
+
+	return merge_all(pointers, resource);
+}
+
+dictionary_creator::letter_type dictionary_creator::Dictionary::get_first_letter(const dictionary_creator::utf8_string &word) const
+{
+	return uppercase_letter(first_letter(word, language), language);
+}
+
+std::optional<dictionary_creator::letter_type> dictionary_creator::Dictionary::probe_first_letter(const dictionary_creator::utf8_string &word) const
+{
+	if (word.empty())
+	{
+		return std::nullopt;
+	}
+
+	return try_uppercase_letter(first_letter(word, language), language);
+}
+
+bool dictionary_creator::Dictionary::add_word(utf8_string word)
+{
+	letter_type first_letter = get_first_letter(word);
+
+	if (auto found = dictionary[first_letter].find(dictionary_creator::CollatedWord{ word }); found == dictionary[first_letter].end())
+	{
+		auto [iterator, emplacement_happened] =
+			dictionary[first_letter].insert(make_entry(std::move(word)));
+		register_entry(*iterator);
+		track_new_word(*iterator);
+		return emplacement_happened;
+	}
+	else
+	{
+		register_entry(*increment_counter(dictionary[first_letter], found));
+		return false;
+	}
+}
+
+bool dictionary_creator::Dictionary::remove_word(utf8_string word)
+{
+	const auto first_letter = probe_first_letter(word);
+	if (!first_letter)
+	{
+		return false;
+	}
+
+	auto letter = dictionary.find(*first_letter);
+	if (letter == dictionary.end())
+	{
+		return false;
+	}
+
+	auto &entries = letter->second;
+
+	if (auto found = entries.find(dictionary_creator::CollatedWord{ word }); found != entries.end())
+	{
+		entries.erase(found);
+		unregister_entry(word);
+		return true;
+	}
+
+	return false;
+}
+
+void dictionary_creator::Dictionary::add_proper_noun(utf8_string proper_noun)
+{
+	letter_type first_letter = get_first_letter(proper_noun);
+
+	if (auto [iterator, success] = proper_nouns[first_letter].insert(make_entry(std::move(proper_noun))); success)
+	{
+		track_new_proper_noun(*iterator);
+	}
+}
+
+std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Dictionary::lookup(dictionary_creator::utf8_string word) const
+{
+	if (word_filter && !word_filter->may_contain(word))
+	{
+		return nullptr;
+	}
+
+	// a word of another alphabet or a letter this dictionary lacks is a miss rather than an error
+	const auto first_letter = probe_first_letter(word);
+	if (!first_letter)
+	{
+		return nullptr;
+	}
+
+	auto letter = dictionary.find(*first_letter);
+	if (letter == dictionary.end())
+	{
+		return nullptr;
+	}
+
+	const auto &entries = letter->second;
+
+	if (auto iterator = entries.find(dictionary_creator::CollatedWord{ std::move(word) }); iterator != entries.end())
+	{
+		return *iterator;
+	}
+
+	return nullptr;
+}
+
+size_t dictionary_creator::Dictionary::total_words() const
+{
+	size_t result = 0;
+
+	for (const auto &[letter, words]: dictionary)
+	{
+		result += words.size();
+	}
+
+	return result;
+}
+
+dictionary_creator::MemoryReport dictionary_creator::Dictionary::memory_usage() const
+{
+	using bucket_type = default_dictionary_type::mapped_type;
+
+	constexpr size_t letter_node_bytes = list_node_overhead + sizeof(default_dictionary_type::value_type) + sizeof(default_dictionary_type::iterator);
+	constexpr size_t entry_node_bytes = tree_node_overhead + sizeof(bucket_type::value_type);
+	constexpr size_t entry_bytes = control_block_overhead + sizeof(dictionary_creator::Entry);
+	constexpr size_t bucket_bytes = control_block_overhead + sizeof(bucket_type::container_type);
+	constexpr size_t location_bytes = control_block_overhead + sizeof(dictionary_creator::DefinitionsLocation);
+
+	const auto definitions_bytes = [] (const dictionary_creator::Entry &entry)
+	{
+		return entry.get_compact_definitions().memory_usage() + (entry.has_definitions_apart() ? location_bytes : 0);
+	};
+
+	dictionary_creator::MemoryReport report;
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		auto &usage = report.letters[letter];
+
+		usage.container_nodes += letter_node_bytes + string_heap_bytes(letter.size()) + entries.size() * entry_node_bytes;
+		usage.container_nodes += entries.empty() ? 0 : bucket_bytes;
+		usage.entries += entries.size() * entry_bytes;
+
+		for (const auto &entry: entries)
+		{
+			usage.word_strings += string_heap_bytes(std::strlen(*entry)) + string_heap_bytes(entry->get_sort_key().size());
+			usage.definitions += definitions_bytes(*entry);
+		}
+	}
+
+	for (const auto &[letter, entries]: proper_nouns)
+	{
+		auto &usage = report.letters[letter];
+
+		usage.proper_nouns += letter_node_bytes + string_heap_bytes(letter.size()) + entries.size() * (entry_node_bytes + entry_bytes);
+		usage.proper_nouns += entries.empty() ? 0 : bucket_bytes;
+
+		for (const auto &entry: entries)
+		{
+			usage.proper_nouns += string_heap_bytes(std::strlen(*entry)) + string_heap_bytes(entry->get_sort_key().size()) + definitions_bytes(*entry);
+		}
+	}
+
+	for (const auto &[letter, usage]: report.letters)
+	{
+		report.overall += usage;
+	}
+
+	return report;
+}
+
+dictionary_creator::FrozenDictionary dictionary_creator::Dictionary::freeze() const
+{
+	dictionary_creator::subset_t entries;
+	entries.reserve(total_words());
+
+	for (const auto &[letter, words]: dictionary)
+	{
+		entries.insert(entries.end(), words.begin(), words.end());
+	}
+
+	return dictionary_creator::FrozenDictionary(language, entries);
+}
+
+dictionary_creator::InternedDictionary dictionary_creator::Dictionary::intern(dictionary_creator::StringPool &symbols) const
+{
+	dictionary_creator::subset_t entries;
+	entries.reserve(total_words());
+
+	for (const auto &[letter, words]: dictionary)
+	{
+		entries.insert(entries.end(), words.begin(), words.end());
+	}
+
+	return dictionary_creator::InternedDictionary(language, entries, symbols);
+}
+
+dictionary_creator::Dictionary dictionary_creator::Dictionary::from_interned(const dictionary_creator::InternedDictionary &interned,
+		std::pmr::memory_resource *resource)
+{
+	const auto words = interned.counted_words();
+
+	return from_sorted(interned.get_language(), words.begin(), words.end(), resource);
+}
+
+void dictionary_creator::Dictionary::enable_prefix_index()
+{
+	if (prefix_index)
+	{
+		return;
+	}
+
+	prefix_index.emplace();
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		for (const auto &entry: entries)
+		{
+			prefix_index->insert(entry);
+		}
+	}
+}
+
+bool dictionary_creator::Dictionary::has_prefix_index() const noexcept
+{
+	return prefix_index.has_value();
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_completions(dictionary_creator::utf8_string prefix, size_t number) const
+{
+	if (prefix_index)
+	{
+		return prefix_index->complete(prefix, number);
+	}
+
+	auto more_frequent = criteria_dependent_sorters[static_cast<size_t>(dictionary_creator::ComparisonType::MostFrequent)];
+	dictionary_creator::subset_t result;
+
+	auto consider = [&result, &more_frequent, number] (const std::shared_ptr<dictionary_creator::Entry> &entry)
+	{
+		if (result.size() < number)
+		{
+			result.push_back(entry);
+			std::push_heap(result.begin(), result.end(), more_frequent);
+		}
+		else if (number != 0 && more_frequent(entry, result.front()))
+		{
+			std::pop_heap(result.begin(), result.end(), more_frequent);
+			result.back() = entry;
+			std::push_heap(result.begin(), result.end(), more_frequent);
+		}
+	};
+
+	if (prefix.empty())
+	{
+		for (const auto &[letter, entries]: dictionary)
+		{
+			std::for_each(entries.begin(), entries.end(), consider);
+		}
+	}
+	else
+	{
+		const auto first_letter = probe_first_letter(prefix);
+		if (!first_letter)
+		{
+			return result;
+		}
+
+		if (auto letter = dictionary.find(*first_letter); letter != dictionary.end())
+		{
+			// collation order doesn't keep the words sharing a prefix together, côte lies between cote and coté
+			for (const auto &entry: letter->second)
+			{
+				if (std::strncmp(*entry, prefix.c_str(), prefix.size()) == 0)
+				{
+					consider(entry);
+				}
+			}
+		}
+	}
+
+	std::sort_heap(result.begin(), result.end(), more_frequent);
+
+	return result;
+}
+
+void dictionary_creator::Dictionary::enable_fuzzy_index(size_t max_distance)
+{
+	if (fuzzy_index && fuzzy_index->get_max_distance() >= max_distance)
+	{
+		return;
+	}
+
+	fuzzy_index.emplace(max_distance);
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		for (const auto &entry: entries)
+		{
+			fuzzy_index->insert(entry);
+		}
+	}
+}
+
+bool dictionary_creator::Dictionary::has_fuzzy_index() const noexcept
+{
+	return fuzzy_index.has_value();
+}
+
+void dictionary_creator::Dictionary::enable_word_filter(double false_positive_rate)
+{
+	if (word_filter && word_filter->get_false_positive_rate() == false_positive_rate)
+	{
+		return;
+	}
+
+	rebuild_word_filter(false_positive_rate);
+}
+
+bool dictionary_creator::Dictionary::has_word_filter() const noexcept
+{
+	return word_filter.has_value();
+}
+
+void dictionary_creator::Dictionary::rebuild_word_filter(double false_positive_rate)
+{
+	const auto words = total_words();
+
+	// twice the words there are, so that a growing dictionary rebuilds it a logarithmic number of times
+	dictionary_creator::WordFilter filter(false_positive_rate, 2 * words);
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		for (const auto &entry: entries)
+		{
+			filter.insert(static_cast<const char *>(*entry));
+		}
+	}
+
+	word_filter = std::move(filter);
+}
+
+void dictionary_creator::Dictionary::enable_word_sketch(size_t size)
+{
+	if (word_sketch && word_sketch->size() == size)
+	{
+		return;
+	}
+
+	word_sketch = build_word_sketch(size);
+}
+
+bool dictionary_creator::Dictionary::has_word_sketch() const noexcept
+{
+	return word_sketch.has_value();
+}
+
+dictionary_creator::WordSketch dictionary_creator::Dictionary::get_word_sketch() const
+{
+	return word_sketch ? *word_sketch : build_word_sketch(dictionary_creator::WordSketch::default_size);
+}
+
+dictionary_creator::WordSketch dictionary_creator::Dictionary::build_word_sketch(size_t size) const
+{
+	dictionary_creator::WordSketch sketch(size);
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		for (const auto &entry: entries)
+		{
+			sketch.insert(static_cast<const char *>(*entry));
+		}
+	}
+
+	return sketch;
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_suggestions(dictionary_creator::utf8_string word, size_t number, size_t distance) const
+{
+	if (fuzzy_index && fuzzy_index->get_max_distance() >= distance)
+	{
+		return fuzzy_index->suggest(word, number, distance);
+	}
+
+	std::vector<std::pair<size_t, std::shared_ptr<dictionary_creator::Entry>>> found;
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		for (const auto &entry: entries)
+		{
+			if (auto current = dictionary_creator::edit_distance(word, static_cast<const char *>(*entry)); current <= distance)
+			{
+				found.emplace_back(current, entry);
+			}
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [] (const auto &a, const auto &b)
+		{
+			if (a.second->get_counter() != b.second->get_counter())
+			{
+				return a.second->get_counter() > b.second->get_counter();
+			}
+			else if (a.first != b.first)
+			{
+				return a.first < b.first;
+			}
+			return a.second->get_word() < b.second->get_word();
+		});
+
+	dictionary_creator::subset_t result;
+	for (size_t i = 0; i != found.size() && i != number; ++i)
+	{
+		result.push_back(found[i].second);
+	}
+
+	return result;
+}
+
+void dictionary_creator::Dictionary::register_entry(const std::shared_ptr<dictionary_creator::Entry> &entry)
+{
+	if (prefix_index)
+	{
+		prefix_index->insert(entry);
+	}
+
+	if (fuzzy_index)
+	{
+		fuzzy_index->insert(entry);
+	}
+
+	if (word_filter && word_filter->insert(static_cast<const char *>(*entry)) && word_filter->needs_rebuild())
+	{
+		rebuild_word_filter(word_filter->get_false_positive_rate());
+	}
+
+	if (word_sketch)
+	{
+		word_sketch->insert(static_cast<const char *>(*entry));
+	}
+}
+
+void dictionary_creator::Dictionary::unregister_entry(const dictionary_creator::utf8_string &word)
+{
+	if (prefix_index)
+	{
+		prefix_index->erase(word);
+	}
+
+	if (fuzzy_index)
+	{
+		fuzzy_index->erase(word);
+	}
+
+	if (word_filter)
+	{
+		word_filter->forget();
+
+		if (word_filter->needs_rebuild())
+		{
+			rebuild_word_filter(word_filter->get_false_positive_rate());
+		}
+	}
+
+	if (word_sketch)
+	{
+		word_sketch->erase(word);
+
+		if (word_sketch->needs_rebuild())
+		{
+			word_sketch = build_word_sketch(word_sketch->size());
+		}
+	}
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_top(dictionary_creator::ComparisonType criterion, size_t quantity) const
+{
+	const auto &sorter = dictionary_creator::criteria_dependent_sorters[static_cast<size_t>(criterion)];
+
+	return select_top(quantity,
+		[] (const std::shared_ptr<dictionary_creator::Entry> &entry) { return &entry; },
+		[&sorter] (const std::shared_ptr<dictionary_creator::Entry> *a, const std::shared_ptr<dictionary_creator::Entry> *b) { return sorter(*a, *b); });
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_top(dictionary_creator::ComparisonType criterion, size_t quantity,
+	dictionary_creator::ThreadPool &pool) const
+{
+	const auto &sorter = dictionary_creator::criteria_dependent_sorters[static_cast<size_t>(criterion)];
+
+	const bool parallel = pool.size() > 1 && total_words() >= parallel_top_words;
+
+	return select_top(quantity,
+		[] (const std::shared_ptr<dictionary_creator::Entry> &entry) { return &entry; },
+		[&sorter] (const std::shared_ptr<dictionary_creator::Entry> *a, const std::shared_ptr<dictionary_creator::Entry> *b) { return sorter(*a, *b); },
+		parallel ? &pool : nullptr);
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_letter_entries(dictionary_creator::letter_type letter) const
+{
+	dictionary_creator::subset_t entries;
+
+	// a letter of another alphabet has no entries either
+	if (const auto uppercase = try_uppercase_letter(std::move(letter), language); !uppercase)
+	{
+		return entries;
+	}
+	else if (auto found = dictionary.find(*uppercase); found != dictionary.end())
+	{
+		entries.assign(found->second.begin(), found->second.end());
+	}
+
+	return entries;
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_undefined() const
+{
+	dictionary_creator::subset_t result;
+
+	for (const auto &[letter, entries]: dictionary)
+	{
+		for (const auto &entry: entries)
+		{
+			if (entry->is_defined() == false)
+			{
+				result.push_back(entry);
+			}
+		}
+	}
+
+	return result;
+}
+
+std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Dictionary::get_random_word() const
+{
+	if (total_words() == 0)
+	{
+		throw dictionary_creator::dictionary_runtime_error("attempt to get random word from an empty dictionary");
+	}
+
+	auto letter = dictionary.begin();
+	std::advance(letter, random_number(dictionary.size()));
+
+	while (letter->second.empty())
+	{
+		letter = dictionary.begin();
+		std::advance(letter, random_number(dictionary.size()));
+	}
+
+	auto word = letter->second.begin();
+	std::advance(word, random_number(letter->second.size()));
+	return *word;
+}
+
+dictionary_creator::subset_t dictionary_creator::Dictionary::get_random_words(size_t number) const
+{
+	if (number > 100)
+	{
+		dictionary_creator::subset_t all_entries;
+		all_entries.reserve(total_words());
+
+		for (const auto &[letter, entries]: dictionary)
+		{
+			for (const auto &entry: entries)
+			{
+				all_entries.push_back(entry);
+			}
+		}
+
+		while (all_entries.size() > number)
+		{
+			auto it = all_entries.begin() + random_number(all_entries.size());
+			std::swap(*it, *all_entries.rbegin());
+			all_entries.pop_back();
+		}
+
+		all_entries.shrink_to_fit();
+		return all_entries;
+	}
+	else
+	{
+		number = std::min(number, total_words());
+
+		std::set<std::shared_ptr<dictionary_creator::Entry>> set;
+
+		while (set.size() != number)
+		{
+			set.insert(get_random_word());
+		}
+	
+		return dictionary_creator::subset_t(set.begin(), set.end());
+	}
+}
+
+size_t dictionary_creator::random_number(size_t max)
+{
+	return (max != 0 ? rand() % max : 0);
+}
+
+void dictionary_creator::Dictionary::remove_proper_nouns()
+{
+	if (proper_nouns_rescan)
+	{
+		for (const auto &[letter, entries]: proper_nouns)
+		{
+			for (const auto &word: entries)
+			{
+				if (dictionary[letter].erase(word) != 0)
+				{
+					unregister_entry(word->get_word());
+				}
+			}
+		}
+	}
+	else
 	{
-		for (const auto &[letter, entries]: other.dictionary)
+		for (const auto &proper_noun: unreconciled_proper_nouns)
 		{
-			for (const auto &entry: entries)
+			if (dictionary[get_first_letter(static_cast<const char *>(*proper_noun))].erase(proper_noun) != 0)
 			{
-				dictionary[letter].erase(entry);
+				unregister_entry(proper_noun->get_word());
 			}
 		}
 
-		for (const auto &[letter, entries]: other.proper_nouns)
+		for (const auto &word: unreconciled_words)
 		{
-			for (const auto &entry: entries)
+			auto letter = get_first_letter(word);
+			const dictionary_creator::CollatedWord collated{ word };
+
+			if (auto nouns = proper_nouns.find(letter); nouns != proper_nouns.end() && nouns->second.count(collated) != 0)
 			{
-				proper_nouns[letter].insert(entry);
+				auto &entries = dictionary[letter];
+
+				if (auto found = entries.find(collated); found != entries.end())
+				{
+					entries.erase(found);
+					unregister_entry(word);
+				}
 			}
 		}
-
-		remove_proper_nouns();
 	}
-	else
+
+	unreconciled_words.clear();
+	unreconciled_proper_nouns.clear();
+	proper_nouns_rescan = false;
+}
+
+std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Dictionary::adopt(const std::shared_ptr<dictionary_creator::Entry> &entry,
+		const dictionary_creator::Dictionary &owner) const
+{
+	// entries of derived types can't be copied here, they stay shared as clone() has it
+	if (*owner.resource == *resource || typeid(*entry) != typeid(dictionary_creator::Entry))
 	{
-		dictionary.clear();
+		return entry;
 	}
 
-	return *this;
+	return make_entry(*entry);
 }
 
-dictionary_creator::Dictionary &dictionary_creator::Dictionary::subtract(dictionary_creator::Dictionary &&other)
+void dictionary_creator::Dictionary::adopt_loaded_entries()
 {
-	if (language != other.language)
+	// the archive allocates the entries it reads with new
+	if (*resource == *std::pmr::new_delete_resource())
 	{
-		throw dictionary_creator::dictionary_runtime_error("an attempt to subtract language mismatching dictionaries");
+		return;
 	}
 
-	if (&other != this)
+	for (auto *letters: { &dictionary, &proper_nouns })
 	{
-		for (auto &[letter, entries]: other.dictionary)
+		for (auto &[letter, entries]: *letters)
 		{
+			bucket_type adopted(resource);
 			for (const auto &entry: entries)
 			{
-				dictionary[letter].erase(entry);
+				adopted.insert(adopted.end(), typeid(*entry) == typeid(dictionary_creator::Entry) ? make_entry(*entry) : entry);
 			}
-		}
 
-		for (auto &[letter, entries]: other.proper_nouns)
-		{
-			proper_nouns[letter].merge(std::move(entries));
+			entries = std::move(adopted);
 		}
-
-		remove_proper_nouns();
 	}
-	else
+}
+
+void dictionary_creator::Dictionary::append_sorted(std::shared_ptr<dictionary_creator::Entry> entry,
+		dictionary_creator::letter_type &letter, dictionary_creator::Dictionary::bucket_type *&bucket)
+{
+	if (auto entry_letter = get_first_letter(static_cast<const char *>(*entry)); bucket == nullptr || entry_letter != letter)
 	{
-		dictionary.clear();
+		letter = std::move(entry_letter);
+		bucket = &dictionary[letter];
 	}
 
-	return *this;
+	if (bucket->empty() || dictionary_creator::DefaultEntrySorter{}(*std::prev(bucket->end()), entry))
+	{
+		bucket->insert(bucket->end(), std::move(entry));
+	}
+	else if (auto [position, inserted] = bucket->insert(entry); !inserted)
+	{
+		increment_counter(*bucket, position, entry->get_counter());
+	}
 }
 
-dictionary_creator::Dictionary dictionary_creator::Dictionary::intersection_with(const dictionary_creator::Dictionary &other) const
+void dictionary_creator::Dictionary::merge_bucket(dictionary_creator::Dictionary::bucket_type &entries,
+		const dictionary_creator::Dictionary::bucket_type &others, const dictionary_creator::Dictionary &owner,
+		dictionary_creator::Dictionary::BucketChanges *deferred)
 {
-	if (language != other.language)
+	// a bucket merged into itself is walked through a copy sharing its contents, the first change clones the own ones
+	if (&entries == &others)
 	{
-		throw dictionary_creator::dictionary_runtime_error("an attempt to find intersection of lanugage mismatching dictionaries");
+		const auto source = others;
+		merge_bucket(entries, source, owner, deferred);
+		return;
 	}
 
-	dictionary_creator::Dictionary result(language);
+	const bool noted = prefix_index || fuzzy_index || word_filter || word_sketch || !proper_nouns.empty();
+	const bool lookup = prefers_lookups(others.size(), entries.size());
+	const dictionary_creator::DefaultEntrySorter less;
 
-	for (const auto &[letter, entries]: dictionary)
+	auto position = entries.begin();
+
+	for (const auto &entry: others)
 	{
-		try
+		position = seek(entries, position, entry, lookup);
+
+		const bool added = position == entries.end() || less(entry, *position);
+		if (added)
+		{
+			position = entries.insert(position, adopt(entry, owner));
+		}
+		else
 		{
-			for (const auto &entry : entries)
+			position = increment_counter(entries, position, entry->get_counter());
+		}
+
+		if (deferred == nullptr)
+		{
+			register_entry(*position);
+			if (added)
 			{
-				if (other.dictionary.at(letter).find(entry) != other.dictionary.at(letter).end())
-				{
-					result.dictionary[letter].insert(entry->is_defined() ? entry : *other.dictionary.at(letter).find(entry));
-				}
+				track_new_word(*position);
+			}
+		}
+		else if (noted)
+		{
+			deferred->registered.push_back(*position);
+			if (added)
+			{
+				deferred->added.push_back(*position);
 			}
 		}
-		catch ([[ maybe_unused ]] std::out_of_range &no_such_letter_which_is_ok) { }
+
+		++position;
 	}
+}
 
-	result.proper_nouns = other.proper_nouns;
-	for (const auto &[letter, entries]: proper_nouns)
+void dictionary_creator::Dictionary::subtract_bucket(dictionary_creator::Dictionary::bucket_type &entries,
+		const dictionary_creator::Dictionary::bucket_type &others, dictionary_creator::Dictionary::BucketChanges *deferred)
+{
+	const bool noted = prefix_index || fuzzy_index || word_filter || word_sketch;
+	const bool lookup = prefers_lookups(others.size(), entries.size());
+	const dictionary_creator::DefaultEntrySorter less;
+
+	auto position = entries.begin();
+
+	for (const auto &entry: others)
 	{
-		for (const auto &entry: entries)
+		if (position = seek(entries, position, entry, lookup); position == entries.end())
 		{
-			result.proper_nouns[letter].insert(entry);
+			break;
 		}
-	}
 
-	result.remove_proper_nouns();
+		if (!less(entry, *position))
+		{
+			position = entries.erase(position);
 
-	return result;
+			if (deferred == nullptr)
+			{
+				unregister_entry(entry->get_word());
+			}
+			else if (noted)
+			{
+				deferred->removed.push_back(entry->get_word());
+			}
+		}
+	}
 }
 
-dictionary_creator::letter_type dictionary_creator::Dictionary::get_first_letter(dictionary_creator::utf8_string word) const
+dictionary_creator::Dictionary::bucket_type dictionary_creator::Dictionary::intersect_bucket(const dictionary_creator::Dictionary::bucket_type &entries,
+		const dictionary_creator::Dictionary::bucket_type &others, const dictionary_creator::Dictionary &owner) const
 {
-	return uppercase_letter(first_letter(word, language), language);
-}
+	// the smaller bucket is walked, common words come in the order of the bucket they are appended to
+	const bool own_walked = entries.size() <= others.size();
+	const auto &walked = own_walked ? entries : others;
+	const auto &searched = own_walked ? others : entries;
 
-bool dictionary_creator::Dictionary::add_word(utf8_string word)
-{
-	letter_type first_letter = get_first_letter(word);
+	const bool lookup = prefers_lookups(walked.size(), searched.size());
+	const dictionary_creator::DefaultEntrySorter less;
 
-	if (auto found = dictionary[first_letter].find(word); found == dictionary[first_letter].end())
-	{
-		auto [iterator, emplacement_happened] =
-			dictionary[first_letter].insert(std::make_shared<dictionary_creator::Entry>(std::move(word)));
-		return emplacement_happened;
-	}
-	else
+	bucket_type common(resource);
+	auto position = searched.begin();
+
+	for (const auto &entry: walked)
 	{
-		(*found)->increment_counter();
-		return false;
-	}
-}
+		if (position = seek(searched, position, entry, lookup); position == searched.end())
+		{
+			break;
+		}
 
-bool dictionary_creator::Dictionary::remove_word(utf8_string word)
-{
-	letter_type first_letter = get_first_letter(word);
+		if (!less(entry, *position))
+		{
+			const auto &own = own_walked ? entry : *position;
+			const auto &others_own = own_walked ? *position : entry;
+
+			common.insert(common.end(), own->is_defined() ? own : adopt(others_own, owner));
+		}
+	}
 
-	return dictionary[first_letter].erase(std::make_shared<dictionary_creator::Entry>(std::move(word)));
+	return common;
 }
 
-void dictionary_creator::Dictionary::add_proper_noun(utf8_string proper_noun)
+dictionary_creator::Dictionary::bucket_type dictionary_creator::Dictionary::merge_buckets(
+		const std::vector<std::pair<const dictionary_creator::Dictionary::bucket_type *, const dictionary_creator::Dictionary *>> &buckets) const
 {
-	letter_type first_letter = get_first_letter(proper_noun);
+	struct Cursor
+	{
+		bucket_type::const_iterator position;
+		bucket_type::const_iterator end;
+		size_t source;
+	};
 
-	proper_nouns[first_letter].insert(std::make_shared<dictionary_creator::Entry>(std::move(proper_noun)));
-}
+	const dictionary_creator::DefaultEntrySorter less;
 
-std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Dictionary::lookup(dictionary_creator::utf8_string word) const
-{
-	letter_type first_letter;
-       	try
+	// the heap keeps the cursor at the smallest word on top, of equal words the one of the dictionary given first
+	auto later = [&less] (const Cursor &a, const Cursor &b)
 	{
-		first_letter = get_first_letter(word);
-	}
-	catch ([[ maybe_unused ]] std::exception& possible_broken_UTF8_letter)
+		if (less(*a.position, *b.position))
+		{
+			return false;
+		}
+		return less(*b.position, *a.position) || a.source > b.source;
+	};
+
+	std::vector<Cursor> heap;
+	heap.reserve(buckets.size());
+
+	for (size_t i = 0; i != buckets.size(); ++i)
 	{
-		return nullptr;
+		heap.push_back({ buckets[i].first->begin(), buckets[i].first->end(), i });
 	}
 
-	try
+	std::make_heap(heap.begin(), heap.end(), later);
+
+	bucket_type merged(resource);
+
+	while (!heap.empty())
 	{
-		if (auto iterator = dictionary.at(first_letter).find(std::move(word)); iterator != dictionary.at(first_letter).end())
+		std::pop_heap(heap.begin(), heap.end(), later);
+		auto first = heap.back();
+		heap.pop_back();
+
+		const auto &entry = *first.position;
+		size_t counter = entry->get_counter();
+		bool repeated = false;
+
+		// the same word of the other dictionaries is on top now
+		while (!heap.empty() && !less(entry, *heap.front().position))
+		{
+			std::pop_heap(heap.begin(), heap.end(), later);
+
+			auto &same = heap.back();
+			counter += (*same.position)->get_counter();
+			repeated = true;
+
+			if (++same.position != same.end)
+			{
+				std::push_heap(heap.begin(), heap.end(), later);
+			}
+			else
+			{
+				heap.pop_back();
+			}
+		}
+
+		merged.insert(merged.end(), repeated ? counted_copy(entry, counter) : adopt(entry, *buckets[first.source].second));
+
+		if (++first.position != first.end)
 		{
-			return *iterator;
+			heap.push_back(first);
+			std::push_heap(heap.begin(), heap.end(), later);
 		}
 	}
-	catch (std::out_of_range &) {}
 
-	return nullptr;
+	return merged;
 }
 
-size_t dictionary_creator::Dictionary::total_words() const
+std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Dictionary::counted_copy(const std::shared_ptr<dictionary_creator::Entry> &entry,
+		size_t counter) const
 {
-	size_t result = 0;
+	auto copy = typeid(*entry) == typeid(dictionary_creator::Entry) ? make_entry(*entry) : entry->clone();
 
-	for (const auto &[letter, words]: dictionary)
+	// entries of derived types that can't be copied are changed in place, as increment_counter() has it
+	if (!copy)
 	{
-		result += words.size();
+		copy = entry;
 	}
 
-	return result;
+	copy->set_counter(counter);
+
+	return copy;
 }
 
-dictionary_creator::subset_t dictionary_creator::Dictionary::get_top(dictionary_creator::ComparisonType criterion, size_t quantity) const
+void dictionary_creator::Dictionary::catch_up(std::vector<dictionary_creator::Dictionary::BucketChanges> &changes)
 {
-	size_t total_entries = total_words();
-
-	quantity = std::min(quantity, total_entries);
-
-	dictionary_creator::subset_t entries;
-	entries.reserve(total_entries);
-
-	for (const auto &[letter, words]: dictionary)
+	for (auto &bucket_changes: changes)
 	{
-		for (const auto &w: words)
+		for (const auto &word: bucket_changes.removed)
 		{
-			entries.push_back(w);
+			unregister_entry(word);
 		}
-	}
 
-	std::partial_sort(entries.begin(), entries.begin() + quantity, entries.end(),
-			dictionary_creator::criteria_dependent_sorters[static_cast<size_t>(criterion)]);
-//	std::stable_sort(entries.begin(), entries.end(), dictionary_creator::criteria_dependent_sorters[static_cast<size_t>(criterion)]);
+		for (const auto &entry: bucket_changes.registered)
+		{
+			register_entry(entry);
+		}
 
-	entries.resize(quantity);
+		for (const auto &entry: bucket_changes.added)
+		{
+			track_new_word(entry);
+		}
 
-	return entries;
+		bucket_changes = {};
+	}
 }
 
-dictionary_creator::subset_t dictionary_creator::Dictionary::get_letter_entries(dictionary_creator::letter_type letter) const
+void dictionary_creator::Dictionary::take_proper_nouns(const dictionary_creator::Dictionary &other)
 {
-	dictionary_creator::subset_t entries;
-	letter = uppercase_letter(letter, language);
-
-	try
+	for (const auto &[letter, entries]: other.proper_nouns)
 	{
-		size_t total_entries = dictionary.at(letter).size();
-		entries.reserve(total_entries);
-
-		for (const auto &word: dictionary.at(letter))
+		for (const auto &entry: entries)
 		{
-			entries.push_back(word);
+			if (auto [inserted, success] = proper_nouns[letter].insert(adopt(entry, other)); success)
+			{
+				track_new_proper_noun(*inserted);
+			}
 		}
 	}
-	catch (std::out_of_range &) {}
 
-	return entries;
+	remove_proper_nouns();
 }
 
-dictionary_creator::subset_t dictionary_creator::Dictionary::get_undefined() const
+void dictionary_creator::Dictionary::take_proper_nouns(dictionary_creator::Dictionary &&other)
 {
-	dictionary_creator::subset_t result;
-
-	for (const auto &[letter, entries]: dictionary)
+	for (auto &[letter, entries]: other.proper_nouns)
 	{
+		auto &own_entries = proper_nouns[letter];
+
 		for (const auto &entry: entries)
 		{
-			if (entry->is_defined() == false)
+			if (own_entries.find(entry) == own_entries.end())
 			{
-				result.push_back(entry);
+				track_new_proper_noun(entry);
 			}
 		}
+
+		own_entries.merge(std::move(entries));
 	}
 
-	return result;
+	remove_proper_nouns();
 }
 
-std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Dictionary::get_random_word() const
+void dictionary_creator::Dictionary::clear_words()
 {
-	if (dictionary.empty())
+	dictionary.clear();
+
+	if (prefix_index)
 	{
-		throw dictionary_creator::dictionary_runtime_error("attempt to get random word from an empty dictionary");
+		prefix_index->clear();
 	}
 
-	auto letter = dictionary.begin();
-	std::advance(letter, random_number(dictionary.size()));
+	if (fuzzy_index)
+	{
+		fuzzy_index->clear();
+	}
 
-	while (letter->second.empty())
+	if (word_filter)
 	{
-		letter = dictionary.begin();
-		std::advance(letter, random_number(dictionary.size()));
+		word_filter->clear();
 	}
 
-	auto word = letter->second.begin();
-	std::advance(word, random_number(letter->second.size()));
-	return *word;
+	if (word_sketch)
+	{
+		word_sketch->clear();
+	}
 }
 
-dictionary_creator::subset_t dictionary_creator::Dictionary::get_random_words(size_t number) const
+void dictionary_creator::Dictionary::give_proper_nouns(dictionary_creator::Dictionary &result, const dictionary_creator::Dictionary &other) const
 {
-	if (number > 100)
+	if (*other.resource == *resource)
 	{
-		dictionary_creator::subset_t all_entries;
-		all_entries.reserve(total_words());
-
-		for (const auto &[letter, entries]: dictionary)
+		result.proper_nouns = other.proper_nouns;
+	}
+	else
+	{
+		for (const auto &[letter, entries]: other.proper_nouns)
 		{
 			for (const auto &entry: entries)
 			{
-				all_entries.push_back(entry);
+				result.proper_nouns[letter].insert(result.adopt(entry, other));
 			}
 		}
+	}
 
-		while (all_entries.size() > number)
+	for (const auto &[letter, entries]: proper_nouns)
+	{
+		for (const auto &entry: entries)
 		{
-			auto it = all_entries.begin() + random_number(all_entries.size());
-			std::swap(*it, *all_entries.rbegin());
-			all_entries.pop_back();
+			result.proper_nouns[letter].insert(entry);
 		}
-
-		all_entries.shrink_to_fit();
-		return all_entries;
 	}
-	else
+
+	result.proper_nouns_rescan = true;
+	result.remove_proper_nouns();
+}
+
+void dictionary_creator::Dictionary::track_new_word(const std::shared_ptr<dictionary_creator::Entry> &entry)
+{
+	// only the proper nouns known by now can catch the word, those added later are checked against the whole dictionary
+	if (proper_nouns_rescan || proper_nouns.empty())
 	{
-		number = std::min(number, total_words());
+		return;
+	}
 
-		std::set<std::shared_ptr<dictionary_creator::Entry>> set;
+	unreconciled_words.emplace_back(static_cast<const char *>(*entry));
 
-		while (set.size() != number)
+	// once the delta outgrows the proper nouns, rescanning all of them is cheaper than checking it word by word
+	if (auto size = unreconciled_words.size(); (size & (size - 1)) == 0)
+	{
+		size_t proper_nouns_number = 0;
+		for (const auto &[letter, entries]: proper_nouns)
 		{
-			set.insert(get_random_word());
+			proper_nouns_number += entries.size();
+		}
+
+		if (size > proper_nouns_number)
+		{
+			unreconciled_words.clear();
+			unreconciled_proper_nouns.clear();
+			proper_nouns_rescan = true;
 		}
-	
-		return dictionary_creator::subset_t(set.begin(), set.end());
 	}
 }
 
-size_t dictionary_creator::random_number(size_t max)
+dictionary_creator::Dictionary::bucket_type::const_iterator dictionary_creator::Dictionary::unshared_entry(dictionary_creator::Dictionary::bucket_type &entries,
+		dictionary_creator::Dictionary::bucket_type::const_iterator position)
 {
-	return (max != 0 ? rand() % max : 0);
+	// besides the bucket, each enabled index holds a reference to every entry
+	const long owners = 1 + (prefix_index ? 1 : 0) + (fuzzy_index ? 1 : 0);
+
+	if (!entries.is_shared() && position->use_count() <= owners)
+	{
+		return position;
+	}
+
+	// extracting from shared contents clones them, the following entry is then no hint for the clone
+	const bool hinted = !entries.is_shared();
+	const auto next = std::next(position);
+
+	auto node = entries.extract(position);
+
+	// copies of plain entries are allocated by the resource of the dictionary as any other of its entries are
+	const auto &entry = node.value();
+	if (auto copy = typeid(*entry) == typeid(dictionary_creator::Entry) ? make_entry(*entry) : entry->clone(); copy)
+	{
+		node.value() = std::move(copy);
+	}
+
+	return hinted ? entries.insert(next, std::move(node)) : entries.insert(std::move(node)).position;
 }
 
-void dictionary_creator::Dictionary::remove_proper_nouns()
+dictionary_creator::Dictionary::bucket_type::const_iterator dictionary_creator::Dictionary::increment_counter(dictionary_creator::Dictionary::bucket_type &entries,
+		dictionary_creator::Dictionary::bucket_type::const_iterator position, size_t increment)
 {
-	for (const auto &[letter, entries]: proper_nouns)
+	position = unshared_entry(entries, position);
+	(*position)->increment_counter(increment);
+
+	return position;
+}
+
+dictionary_creator::Dictionary::bucket_type::const_iterator dictionary_creator::Dictionary::set_counter(dictionary_creator::Dictionary::bucket_type &entries,
+		dictionary_creator::Dictionary::bucket_type::const_iterator position, size_t counter)
+{
+	position = unshared_entry(entries, position);
+	(*position)->set_counter(counter);
+
+	return position;
+}
+
+void dictionary_creator::Dictionary::track_new_proper_noun(const std::shared_ptr<dictionary_creator::Entry> &entry)
+{
+	if (!proper_nouns_rescan)
 	{
-		for (const auto &word: entries)
-		{
-			dictionary[letter].erase(word);
-		}
+		unreconciled_proper_nouns.push_back(entry);
 	}
 }
 
@@ -414,6 +1897,11 @@ dictionary_creator::Language dictionary_creator::Dictionary::get_language() cons
 	return language;
 }
 
+std::pmr::memory_resource *dictionary_creator::Dictionary::get_memory_resource() const noexcept
+{
+	return resource;
+}
+
 const dictionary_creator::Dictionary::default_dictionary_type& dictionary_creator::Dictionary::get_main_dictionary() const noexcept
 {
 	return dictionary;
@@ -446,7 +1934,34 @@ dictionary_creator::Dictionary &dictionary_creator::Dictionary::operator-=(dicti
 
 dictionary_creator::Dictionary &dictionary_creator::Dictionary::operator*=(const dictionary_creator::Dictionary &other)
 {
-	return *this = intersection_with(other);
+	const bool indexed = has_prefix_index();
+	const auto fuzzy_distance = fuzzy_index ? std::optional<size_t>{ fuzzy_index->get_max_distance() } : std::nullopt;
+	const auto false_positive_rate = word_filter ? std::optional<double>{ word_filter->get_false_positive_rate() } : std::nullopt;
+	const auto sketch_size = word_sketch ? std::optional<size_t>{ word_sketch->size() } : std::nullopt;
+
+	*this = intersection_with(other);
+
+	if (indexed)
+	{
+		enable_prefix_index();
+	}
+
+	if (fuzzy_distance)
+	{
+		enable_fuzzy_index(*fuzzy_distance);
+	}
+
+	if (false_positive_rate)
+	{
+		enable_word_filter(*false_positive_rate);
+	}
+
+	if (sketch_size)
+	{
+		enable_word_sketch(*sketch_size);
+	}
+
+	return *this;
 }
 
 dictionary_creator::Dictionary dictionary_creator::operator+(dictionary_creator::Dictionary left, const dictionary_creator::Dictionary &right)
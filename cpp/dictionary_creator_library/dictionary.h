@@ -3,14 +3,31 @@
 #include "dictionary_types.h"
 #include "dictionary_entry.h"
 #include "dictionary_language.h"
+#include "letter_map.h"
+#include "shared_bucket.h"
+#include "frozen_dictionary.h"
+#include "interned_dictionary.h"
+#include "prefix_index.h"
+#include "fuzzy_index.h"
+#include "word_filter.h"
+#include "word_sketch.h"
+#include "thread_pool.h"
 
 #include <vector>
+#include <algorithm>
 #include <iterator>
 #include <ostream>
 #include <array>
+#include <optional>
+#include <memory_resource>
+#include <cstring>
+#include <typeinfo>
+#include <type_traits>
 
 #ifndef BOOST_UNAVAILABLE
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
 #else
 #include <memory>
 #endif
@@ -26,72 +43,218 @@ namespace dictionary_creator
 		Shortest = 3, MostAmbiguous = 4, LeastAmbiguous = 5
 	};
 
+	enum class KeynessMeasure : size_t
+	{
+		LogLikelihood = 0, ChiSquare = 1
+	};
+
 	using entry_sorter_t = const std::function<bool(const std::shared_ptr<Entry> &, const std::shared_ptr<Entry> &)>;
 
 	static const std::array<entry_sorter_t, 6> criteria_dependent_sorters
 	{
 		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) { return a->get_counter() > b->get_counter(); },
 		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) {	return a->get_counter() < b->get_counter(); },
-		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) { return utf8_length(a->get_word()) > utf8_length(b->get_word());	},
-		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) {	return utf8_length(a->get_word()) < utf8_length(b->get_word());	},
+		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) { return a->get_length() > b->get_length(); },
+		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) {	return a->get_length() < b->get_length(); },
 		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b)
 		{
-			size_t a_total = 0;
-			for (const auto &i: a->get_definitions())
-			{
-				a_total += i.second.size();
-			}
-
-			size_t b_total = 0;
-			for (const auto &i: b->get_definitions())
-			{
-				b_total += i.second.size();
-			}
-			return a_total > b_total;
+			return a->count_definitions() > b->count_definitions();
 		},
 		[] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b)
 		{
-			size_t a_total = 0;
-			for (const auto &i: a->get_definitions())
-			{
-				a_total += i.second.size();
-			}
-
-			size_t b_total = 0;
-			for (const auto &i: b->get_definitions())
-			{
-				b_total += i.second.size();
-			}
-			return a_total < b_total;
+			return a->count_definitions() < b->count_definitions();
 		}
 	};
 
+	// A word along with its collation key, so that the key is computed once per lookup rather than per comparison
+	struct CollatedWord
+	{
+		explicit CollatedWord(utf8_string word);
+
+		utf8_string sort_key;
+		utf8_string word;
+	};
+
+	// Orders entries by collation keys, words themselves only break ties between equal keys
 	class DefaultEntrySorter
 	{
 	public:
 		bool operator()(const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b) const noexcept;
 
 		using is_transparent = int;
-		bool operator()(const std::shared_ptr<Entry> &a, const dictionary_creator::utf8_string &b) const noexcept;
-		bool operator()(const dictionary_creator::utf8_string &a, const std::shared_ptr<Entry> &b) const noexcept;
+		bool operator()(const std::shared_ptr<Entry> &a, const CollatedWord &b) const noexcept;
+		bool operator()(const CollatedWord &a, const std::shared_ptr<Entry> &b) const noexcept;
+		bool operator()(const std::shared_ptr<Entry> &a, const dictionary_creator::utf8_string &b) const;
+		bool operator()(const dictionary_creator::utf8_string &a, const std::shared_ptr<Entry> &b) const;
 	};
 
 	template <typename T>
 	using less_comp_t = std::function<bool(const T&, const T&)>;
 
+	// the T a comparator of two const T & takes, read off its call operator without wrapping it into a less_comp_t
+	template <typename Comparator>
+	struct compared_type : compared_type<decltype(&Comparator::operator())> {};
+	template <typename T>
+	struct compared_type<bool (*)(const T&, const T&)> { using type = T; };
+	template <typename C, typename T>
+	struct compared_type<bool (C::*)(const T&, const T&) const> { using type = T; };
+	template <typename C, typename T>
+	struct compared_type<bool (C::*)(const T&, const T&)> { using type = T; };
+	template <typename Comparator>
+	using compared_type_t = typename compared_type<std::decay_t<Comparator>>::type;
+
 	using subset_t = std::vector<std::shared_ptr<Entry>>;
 
+	// Approximate heap footprint in bytes, modelled after the libstdc++ layout of the containers involved;
+	// entries and container_nodes of the main dictionary stay within a percent of what its memory resource hands out.
+	//
+	// 	-- word_strings counts the word and sort key buffers that don't fit into the small string optimization
+	// 	-- entries counts Entry objects together with their shared_ptr control blocks, user subclasses as Entry
+	// 	-- definitions counts the definition arrays of entries; their strings are pooled for the whole process and never
+	// 	   counted here, nor freed with the dictionary, see StringPool::memory_usage();
+	// 	   for definitions kept apart only their location is counted, the ones read are cached by their DefinitionsSection
+	// 	-- proper_nouns counts everything kept in the proper nouns dictionary
+	// 	-- container_nodes counts the set nodes and the letter buckets of the main dictionary
+	// 	-- buckets and entries shared by copies of a dictionary are counted in each copy, optional indexes are not counted
+	struct MemoryUsage
+	{
+		size_t word_strings = 0;
+		size_t entries = 0;
+		size_t definitions = 0;
+		size_t proper_nouns = 0;
+		size_t container_nodes = 0;
+
+		size_t total() const noexcept;
+		MemoryUsage &operator+=(const MemoryUsage &other) noexcept;
+	};
+
+	struct MemoryReport
+	{
+		MemoryUsage overall;
+		std::map<letter_type, MemoryUsage> letters;
+	};
+
+	// What turns one dictionary into another, as Dictionary::diff() finds it and Dictionary::apply() replays it.
+	//
+	// 	-- entries carry their counters and definitions; words both dictionaries have carry only the newer counter,
+	// 	   unless the newer one has defined them, then the whole entry is carried in defined
+	// 	-- definitions changed or dropped by an entry defined on both sides don't travel
+	// 	-- archived on its own, so that a replica can be updated without shipping the whole dictionary
+	struct DictionaryDelta
+	{
+		Language language = Language::Uninitialized;
+		subset_t added;
+		std::vector<utf8_string> removed;
+		std::vector<std::pair<utf8_string, size_t>> counters;
+		subset_t defined;
+		std::vector<utf8_string> added_proper_nouns;
+		std::vector<utf8_string> removed_proper_nouns;
+
+		bool empty() const noexcept;
+
+		template <typename A>
+		void serialize(A &arch, [[ maybe_unused ]] const unsigned int version)
+		{
+			arch & language;
+			arch & added;
+			arch & removed;
+			arch & counters;
+			arch & defined;
+			arch & added_proper_nouns;
+			arch & removed_proper_nouns;
+		}
+	};
+
+	// A word used in one dictionary noticeably more often than in a reference one, as Dictionary::keywords() finds it.
+	//
+	// 	-- score is the log-likelihood (G2) or the Pearson chi-square of the 2x2 table of the word's counter
+	// 	   and the counters of all the other words on both sides; all four cells count in either of them
+	// 	-- reference_counter is 0 for a word the reference dictionary lacks
+	// 	-- nothing is relatively more frequent than in an empty reference dictionary, it yields no keywords at all
+	struct Keyword
+	{
+		std::shared_ptr<Entry> entry;
+		size_t reference_counter = 0;
+		double score = 0.0;
+	};
+
 	class Dictionary
 	{
 	public:
-		Dictionary(Language language);
+		// entries, letter buckets and their nodes are allocated by the resource, which has to outlive the dictionary,
+		// its copies and every entry taken from it; words merged from dictionaries using other resources are copied into it;
+		// the text of definitions lives in the process-wide StringPool::shared() instead and outlives the dictionary
+		Dictionary(Language language, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
+		// both sides are walked letter by letter in their common order, a small side is looked up in a large one instead
 		Dictionary &merge(const Dictionary &other);
 		Dictionary &merge(Dictionary &&other);
 		Dictionary &subtract(const Dictionary &other);
 		Dictionary &subtract(Dictionary &&other);
 		Dictionary intersection_with(const Dictionary &other) const;
 
+		// the same, letters are processed concurrently by the pool, the largest buckets first;
+		// the memory resource has to be safe to use from several threads, as the default one is
+		Dictionary &merge(const Dictionary &other, ThreadPool &pool);
+		Dictionary &subtract(const Dictionary &other, ThreadPool &pool);
+		Dictionary intersection_with(const Dictionary &other, ThreadPool &pool) const;
+
+		// what has to change in this dictionary to make it the other one, found in a single walk of both;
+		// letters both dictionaries still share since one was copied from the other aren't walked at all
+		DictionaryDelta diff(const Dictionary &other) const;
+		// replays a delta, entries it carries are copied into this dictionary
+		Dictionary &apply(const DictionaryDelta &delta);
+
+		// the words relatively more frequent here than in the reference dictionary, highest scores first, ties in the word order;
+		// both dictionaries are walked together once their counters are summed up, a small one is looked up in a large reference instead;
+		// only quantity candidates are kept on the way
+		std::vector<Keyword> keywords(const Dictionary &reference, size_t quantity,
+			KeynessMeasure measure = KeynessMeasure::LogLikelihood) const;
+
+		// merges all the dictionaries at once rather than folding them one into another: a single k-way walk per letter,
+		// counters of a word are summed up, proper nouns of every dictionary are removed from the words of all of them once;
+		// a repeated word keeps the entry of the dictionary given first, a letter only one of them has is shared as a whole
+		static Dictionary merge_all(const std::vector<const Dictionary *> &dictionaries,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+		static Dictionary merge_all(const std::vector<Dictionary> &dictionaries,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+		// builds a dictionary from shared_ptr<Entry> or (word, counter) pairs at once;
+		// input ordered as a Dictionary iterates its words takes linear time, any other order a logarithmic one per word;
+		// repeated words add their counters up, a counter below one is an error since no word is stored without encounters
+		template <typename InputIterator>
+		static Dictionary from_sorted(Language language, InputIterator first, InputIterator last,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+		{
+			Dictionary result(language, resource);
+
+			letter_type letter;
+			bucket_type *bucket = nullptr;
+
+			for (; first != last; ++first)
+			{
+				if constexpr (std::is_convertible_v<decltype(*first), std::shared_ptr<Entry>>)
+				{
+					result.append_sorted(*first, letter, bucket);
+				}
+				else
+				{
+					const auto &[word, counter] = *first;
+
+					if (counter < 1)
+					{
+						throw dictionary_runtime_error("an attempt to build a dictionary of a word without encounters");
+					}
+
+					auto entry = result.make_entry(utf8_string{ word });
+					entry->set_counter(static_cast<size_t>(counter));
+					result.append_sorted(std::move(entry), letter, bucket);
+				}
+			}
+
+			return result;
+		}
+
 		template <typename T, typename ... Args>
 		bool add_word(utf8_string word, Args &&... args)
 		{
@@ -99,19 +262,21 @@ namespace dictionary_creator
 	
 			auto first_letter = get_first_letter(word);
 
-			if (auto exists = dictionary[first_letter].find(std::make_shared<Entry>(word)); exists != dictionary[first_letter].end())
+			if (auto exists = dictionary[first_letter].find(CollatedWord{ word }); exists != dictionary[first_letter].end())
 			{
 				auto old_node = dictionary[first_letter].extract(exists);
 				auto counter = old_node.value()->get_counter();
 
-				old_node.value().reset(new T(std::move(word), std::forward<Args>(args)...));
+				old_node.value() = make_entry<T>(std::move(word), std::forward<Args>(args)...);
 				old_node.value()->increment_counter(counter - 1);
-				dictionary[first_letter].insert(std::move(old_node));
+				auto inserted = dictionary[first_letter].insert(std::move(old_node));
+				register_entry(*inserted.position);
 			}
 			else
 			{
-				auto [iterator, success] = dictionary[first_letter].insert(
-						std::shared_ptr<Entry>{ new T(std::move(word), std::forward<Args>(args)...) });
+				auto [iterator, success] = dictionary[first_letter].insert(make_entry<T>(std::move(word), std::forward<Args>(args)...));
+				register_entry(*iterator);
+				track_new_word(*iterator);
 				return success;
 			}
 
@@ -123,52 +288,84 @@ namespace dictionary_creator
 		void add_proper_noun(utf8_string proper_noun);
 		void remove_proper_nouns();
 
+		// the entry itself, shared with the copies of the dictionary, see get_main_dictionary() on later changes of it
 		std::shared_ptr<Entry> lookup(utf8_string word) const;
 		size_t total_words() const;
-
+		MemoryReport memory_usage() const;
+
+		FrozenDictionary freeze() const;
+
+		// words and counters as ids of a symbol table, for set algebra among many dictionaries; from_interned() turns them back
+		// into a Dictionary of plain entries, without the definitions and proper nouns of the origin
+		InternedDictionary intern(StringPool &symbols = StringPool::shared_words()) const;
+		static Dictionary from_interned(const InternedDictionary &interned,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+		void enable_prefix_index();
+		bool has_prefix_index() const noexcept;
+		// the number most frequent words starting with prefix, byte for byte; words with equal counters come in no set order;
+		// without the prefix index the whole bucket of the prefix's first letter is scanned, since collation doesn't keep the
+		// words sharing a prefix together, and an empty prefix scans every letter
+		subset_t get_completions(utf8_string prefix, size_t number) const;
+
+		void enable_fuzzy_index(size_t max_distance = 2);
+		bool has_fuzzy_index() const noexcept;
+		// words at most distance edits away, most frequent first; without a fuzzy index reaching that distance
+		// every word of the dictionary is compared with the given one
+		subset_t get_suggestions(utf8_string word, size_t number, size_t distance = 2) const;
+
+		// lookup() of a word the filter rejects returns at once; the filter follows every change of the dictionary
+		void enable_word_filter(double false_positive_rate = WordFilter::default_false_positive_rate);
+		bool has_word_filter() const noexcept;
+
+		// MinHash sketch of the words, following every change of the dictionary once enabled;
+		// get_word_sketch() of a dictionary without one builds it from scratch
+		void enable_word_sketch(size_t size = WordSketch::default_size);
+		bool has_word_sketch() const noexcept;
+		WordSketch get_word_sketch() const;
+
+		// the entries are streamed through a heap of quantity of them, entries equal by the criterion keep the dictionary order
 		subset_t get_top(ComparisonType criterion, size_t quantity) const;
+		// the same, letters are searched concurrently by the pool, each into a heap of its own, when the dictionary is large enough
+		subset_t get_top(ComparisonType criterion, size_t quantity, ThreadPool &pool) const;
 
 		template <typename T>
 		subset_t get_top(less_comp_t<T> &&comparator, size_t quantity) const
+		{
+			return get_top<T>(comparator, quantity);
+		}
+
+		// entries of type T (or derived from it) ordered by comparator come first, the rest follow in the order of their words;
+		// the comparator is called directly and the type of each entry is resolved once rather than upon every comparison
+		template <typename T, typename Comparator>
+		subset_t get_top(Comparator &&comparator, size_t quantity) const
 		{
 			static_assert(std::is_base_of_v<Entry, T>, "Comparator accepts unrelated to dictionary_creator::Entry types");
+			static_assert(std::is_invocable_r_v<bool, Comparator &, const T &, const T &>, "Comparator doesn't compare two T objects");
 
-			auto hierarchy_aware_comp = [&comparator] (const std::shared_ptr<Entry> &a, const std::shared_ptr<Entry> &b)
-			{
-				const auto *aptr = dynamic_cast<const T *>(a.get());
-				const auto *bptr = dynamic_cast<const T *>(b.get());
+			using candidate_t = std::pair<const T *, const std::shared_ptr<Entry> *>;
 
-				if (aptr != nullptr && bptr != nullptr)
+			return select_top(quantity,
+				[] (const std::shared_ptr<Entry> &word)
 				{
-					return comparator(*aptr, *bptr);
-				}
-				else if (aptr == nullptr && bptr == nullptr && a != nullptr && b != nullptr)
-				{
-					return a->get_word() < b->get_word();
-				}
-
-				return (aptr != nullptr);
-			};
-
-			size_t total = total_words();
-			quantity = std::min(quantity, total);
-			
-			subset_t entries;
-			entries.reserve(total);
+					const Entry &entry = *word;
+					const T *typed = (typeid(entry) == typeid(T)) ? static_cast<const T *>(&entry) : dynamic_cast<const T *>(&entry);
 
-			for (const auto &[letter, words]: dictionary)
-			{
-				for (const auto &word: words)
+					return candidate_t{ typed, &word };
+				},
+				[&comparator] (const candidate_t &a, const candidate_t &b)
 				{
-					entries.push_back(word);
-				}
-			}
-
-			std::partial_sort(entries.begin(), entries.begin() + quantity, entries.end(), hierarchy_aware_comp);
-
-			entries.resize(quantity);
-
-			return entries;
+					if (a.first != nullptr && b.first != nullptr)
+					{
+						return static_cast<bool>(comparator(*a.first, *b.first));
+					}
+					else if (a.first == nullptr && b.first == nullptr)
+					{
+						return std::strcmp(**a.second, **b.second) < 0;
+					}
+
+					return (a.first != nullptr);
+				});
 		}
 
 		subset_t get_letter_entries(letter_type letter) const;
@@ -176,7 +373,9 @@ namespace dictionary_creator
 		std::shared_ptr<Entry> get_random_word() const;
 		subset_t get_random_words(size_t number) const;
 
-		letter_type get_first_letter(utf8_string word) const;
+		letter_type get_first_letter(const utf8_string &word) const;
+		// the same without exceptions, nullopt for an empty word or one no letter of the language starts
+		std::optional<letter_type> probe_first_letter(const utf8_string &word) const;
 
 		Dictionary &operator+=(const Dictionary &other);
 		Dictionary &operator+=(Dictionary &&other);
@@ -185,15 +384,187 @@ namespace dictionary_creator
 		Dictionary &operator*=(const Dictionary &other);
 		
 		Language get_language() const noexcept;
-
-		using default_dictionary_type = std::map<letter_type, std::set<std::shared_ptr<Entry>, DefaultEntrySorter>, string_comp>;
+		std::pmr::memory_resource *get_memory_resource() const noexcept;
+
+		// buckets and entries are shared between copies until either of them changes:
+		// 	-- an entry held by anything else besides this dictionary is copied before the dictionary changes its counter,
+		// 	   so entries returned by lookup(), get_top() and the like are snapshots of the counter as it was then
+		// 	-- define(), increment_counter() and set_counter() called on an entry itself change it for every dictionary and holder sharing it
+		using bucket_type = SharedBucket<std::pmr::set<std::shared_ptr<Entry>, DefaultEntrySorter>>;
+		using default_dictionary_type = LetterMap<bucket_type>;
 		const default_dictionary_type& get_main_dictionary() const noexcept;
 		const default_dictionary_type& get_proper_nouns_dictionary() const noexcept;
 
 	private:
 		Language language;
+		std::pmr::memory_resource *resource;
 		default_dictionary_type dictionary;
 		default_dictionary_type proper_nouns;
+		std::optional<PrefixIndex> prefix_index;
+		std::optional<FuzzyIndex> fuzzy_index;
+		std::optional<WordFilter> word_filter;
+		std::optional<WordSketch> word_sketch;
+
+		// words and proper nouns added since the last remove_proper_nouns(), only they can have got into both dictionaries;
+		// when the delta is not known (loaded from an archive, grown larger than the proper nouns themselves) everything is rescanned
+		std::vector<utf8_string> unreconciled_words;
+		subset_t unreconciled_proper_nouns;
+		bool proper_nouns_rescan = false;
+
+		void register_entry(const std::shared_ptr<Entry> &entry);
+		void unregister_entry(const utf8_string &word);
+		void rebuild_word_filter(double false_positive_rate);
+		WordSketch build_word_sketch(size_t size) const;
+		void track_new_word(const std::shared_ptr<Entry> &entry);
+		void append_sorted(std::shared_ptr<Entry> entry, letter_type &letter, bucket_type *&bucket);
+
+		// what a concurrent bucket walk did, for the indexes and the proper nouns to catch up with afterwards
+		struct BucketChanges
+		{
+			subset_t registered;
+			subset_t added;
+			std::vector<utf8_string> removed;
+		};
+
+		void merge_bucket(bucket_type &entries, const bucket_type &others, const Dictionary &owner, BucketChanges *deferred = nullptr);
+		void subtract_bucket(bucket_type &entries, const bucket_type &others, BucketChanges *deferred = nullptr);
+		bucket_type intersect_bucket(const bucket_type &entries, const bucket_type &others, const Dictionary &owner) const;
+		bucket_type merge_buckets(const std::vector<std::pair<const bucket_type *, const Dictionary *>> &buckets) const;
+		std::shared_ptr<Entry> counted_copy(const std::shared_ptr<Entry> &entry, size_t counter) const;
+		void catch_up(std::vector<BucketChanges> &changes);
+		void put_entry(const std::shared_ptr<Entry> &entry);
+		void take_proper_nouns(const Dictionary &other);
+		// other has the same resource, its buckets are taken over
+		void take_proper_nouns(Dictionary &&other);
+		// every word is dropped, the indexes stay enabled and empty
+		void clear_words();
+		void give_proper_nouns(Dictionary &result, const Dictionary &other) const;
+
+		// the quantity entries best by their keys, best first, without gathering the rest of them: a bounded heap keeps
+		// the worst entry taken so far on top, an entry coming later in the dictionary loses a tie; with a pool every letter
+		// is searched into a heap of its own, key and better have to be safe to call concurrently then
+		template <typename Key, typename Better>
+		subset_t select_top(size_t quantity, Key &&key, Better &&better, ThreadPool *pool = nullptr) const
+		{
+			using key_t = std::decay_t<std::invoke_result_t<Key &, const std::shared_ptr<Entry> &>>;
+
+			struct Candidate
+			{
+				key_t key;
+				size_t order;
+				const std::shared_ptr<Entry> *entry;
+			};
+
+			auto ahead = [&better] (const Candidate &a, const Candidate &b)
+			{
+				if (better(a.key, b.key))
+				{
+					return true;
+				}
+
+				return !better(b.key, a.key) && a.order < b.order;
+			};
+
+			auto offer = [&ahead, quantity] (std::vector<Candidate> &heap, Candidate candidate)
+			{
+				if (heap.size() < quantity)
+				{
+					heap.push_back(std::move(candidate));
+					std::push_heap(heap.begin(), heap.end(), ahead);
+				}
+				else if (ahead(candidate, heap.front()))
+				{
+					std::pop_heap(heap.begin(), heap.end(), ahead);
+					heap.back() = std::move(candidate);
+					std::push_heap(heap.begin(), heap.end(), ahead);
+				}
+			};
+
+			quantity = std::min(quantity, total_words());
+			if (quantity == 0)
+			{
+				return {};
+			}
+
+			std::vector<Candidate> heap;
+			heap.reserve(quantity);
+
+			if (pool == nullptr)
+			{
+				size_t order = 0;
+				for (const auto &[letter, words]: dictionary)
+				{
+					for (const auto &word: words)
+					{
+						offer(heap, Candidate{ key(word), order++, &word });
+					}
+				}
+			}
+			else
+			{
+				// orders continue from one letter to the next, so that ties are broken as they are without the pool
+				std::vector<const bucket_type *> buckets;
+				std::vector<size_t> weights;
+				std::vector<size_t> first_orders;
+
+				size_t order = 0;
+				for (const auto &[letter, words]: dictionary)
+				{
+					buckets.push_back(&words);
+					weights.push_back(words.size());
+					first_orders.push_back(order);
+					order += words.size();
+				}
+
+				std::vector<std::vector<Candidate>> letter_heaps(buckets.size());
+
+				pool->run(weights, [&] (size_t i)
+					{
+						letter_heaps[i].reserve(std::min(quantity, buckets[i]->size()));
+
+						size_t letter_order = first_orders[i];
+						for (const auto &word: *buckets[i])
+						{
+							offer(letter_heaps[i], Candidate{ key(word), letter_order++, &word });
+						}
+					});
+
+				for (auto &letter_heap: letter_heaps)
+				{
+					for (auto &candidate: letter_heap)
+					{
+						offer(heap, std::move(candidate));
+					}
+				}
+			}
+
+			std::sort_heap(heap.begin(), heap.end(), ahead);
+
+			subset_t entries;
+			entries.reserve(heap.size());
+
+			for (const auto &candidate: heap)
+			{
+				entries.push_back(*candidate.entry);
+			}
+
+			return entries;
+		}
+
+		template <typename T = Entry, typename ... Args>
+		std::shared_ptr<Entry> make_entry(Args &&... args) const
+		{
+			return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource), std::forward<Args>(args)...);
+		}
+
+		std::shared_ptr<Entry> adopt(const std::shared_ptr<Entry> &entry, const Dictionary &owner) const;
+		// entries just read from an archive are copied into the resource, derived ones stay as the archive made them
+		void adopt_loaded_entries();
+		// the entry at position turned into one of this dictionary alone, copied first when anything else holds it
+		bucket_type::const_iterator unshared_entry(bucket_type &entries, bucket_type::const_iterator position);
+		bucket_type::const_iterator increment_counter(bucket_type &entries, bucket_type::const_iterator position, size_t increment = 1);
+		bucket_type::const_iterator set_counter(bucket_type &entries, bucket_type::const_iterator position, size_t counter);
+		void track_new_proper_noun(const std::shared_ptr<Entry> &entry);
 
 #ifndef BOOST_UNAVAILABLE
 		friend class boost::serialization::access;
@@ -205,6 +576,20 @@ namespace dictionary_creator
 			arch & language;
 			arch & dictionary;
 			arch & proper_nouns;
+
+			if constexpr (A::is_loading::value)
+			{
+				adopt_loaded_entries();
+
+				prefix_index.reset();
+				fuzzy_index.reset();
+				word_filter.reset();
+				word_sketch.reset();
+
+				unreconciled_words.clear();
+				unreconciled_proper_nouns.clear();
+				proper_nouns_rescan = true;
+			}
 		}
 	};
 
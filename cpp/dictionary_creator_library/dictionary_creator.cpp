@@ -1,8 +1,9 @@
 #include "dictionary_creator.h"
 
-dictionary_creator::DictionaryCreator::DictionaryCreator(Language language)
+dictionary_creator::DictionaryCreator::DictionaryCreator(Language language, std::pmr::memory_resource *resource)
 	:
 	language{ language },
+	resource{ resource },
 	minimal_substantial_word_length{ dictionary_creator::minimal_substantial_word_length[static_cast<size_t>(language)] },
 	terminating_characters{ dictionary_creator::terminating_characters[static_cast<size_t>(language)] },
 	proper_nouns_extractor
@@ -70,7 +71,7 @@ void dictionary_creator::DictionaryCreator::add_input(std::unique_ptr<std::istre
 
 dictionary_creator::Dictionary dictionary_creator::DictionaryCreator::parse_to_dictionary()
 {
-	dictionary_creator::Dictionary result(language);
+	dictionary_creator::Dictionary result(language, resource);
 
 	while (!input_files.empty())
 	{
@@ -87,7 +88,7 @@ dictionary_creator::Dictionary dictionary_creator::DictionaryCreator::parse_to_d
 
 dictionary_creator::Dictionary dictionary_creator::DictionaryCreator::parse_line(dictionary_creator::utf8_string line) const
 {
-	dictionary_creator::Dictionary dictionary(language);
+	dictionary_creator::Dictionary dictionary(language, resource);
 
 	remove_crlf(line);
 
@@ -111,7 +112,7 @@ dictionary_creator::Dictionary dictionary_creator::DictionaryCreator::parse_line
 
 dictionary_creator::Dictionary dictionary_creator::DictionaryCreator::parse_one_file(std::istream &file_input)
 {
-	dictionary_creator::Dictionary dictionary(language);
+	dictionary_creator::Dictionary dictionary(language, resource);
 
 	bool previous_string_terminated = true;
 	utf8_string current_string;
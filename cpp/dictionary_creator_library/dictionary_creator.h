@@ -6,13 +6,15 @@
 #include <queue>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 
 namespace dictionary_creator
 {
 	class DictionaryCreator
 	{
 	public:
-		DictionaryCreator(Language language);
+		// the dictionaries parsed, including the ones of single lines, are allocated by the resource
+		DictionaryCreator(Language language, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
 		void add_input(std::unique_ptr<std::istream> &&uptr_to_stream);
 
@@ -26,6 +28,7 @@ namespace dictionary_creator
 		void remove_crlf(utf8_string &string) const;
 
 		Language language;
+		std::pmr::memory_resource *resource;
 		std::queue<std::unique_ptr<std::istream>> input_files;
 
 		size_t minimal_substantial_word_length;
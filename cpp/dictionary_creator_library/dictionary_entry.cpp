@@ -1,19 +1,54 @@
 #include "dictionary_entry.h"
+#include "dictionary_language.h"
+
+#include <typeinfo>
 
 dictionary_creator::Entry::Entry(dictionary_creator::utf8_string word)
-	: word{ std::move(word) }, encounters{ 1 }, defined{ false }
-{}
+	: word{ std::move(word) }, length{ 0 }, encounters{ 1 }, defined{ false }
+{
+	refresh_word_metrics();
+}
 
 dictionary_creator::utf8_string dictionary_creator::Entry::get_word() const noexcept
 {
 	return word;
 }
 
-const dictionary_creator::definitions_t &dictionary_creator::Entry::get_definitions() const noexcept
+const dictionary_creator::utf8_string &dictionary_creator::Entry::get_sort_key() const noexcept
+{
+	return sort_key;
+}
+
+size_t dictionary_creator::Entry::get_length() const noexcept
+{
+	return length;
+}
+
+dictionary_creator::definitions_t dictionary_creator::Entry::get_definitions() const
+{
+	if (apart)
+	{
+		return apart->section->read(apart->record);
+	}
+
+	return definitions.expand();
+}
+
+const dictionary_creator::CompactDefinitions &dictionary_creator::Entry::get_compact_definitions() const noexcept
 {
 	return definitions;
 }
 
+size_t dictionary_creator::Entry::count_definitions() const noexcept
+{
+	return apart ? apart->count : definitions.count_meanings();
+}
+
+bool dictionary_creator::Entry::has_definitions_apart() const noexcept
+{
+	return apart != nullptr;
+}
+
 bool dictionary_creator::Entry::is_defined() const noexcept
 {
 	return defined;
@@ -23,9 +58,9 @@ const dictionary_creator::Entry &dictionary_creator::Entry::define(const diction
 {
 	if (!defined)
 	{
-		definitions = definer(word);
+		definitions = dictionary_creator::CompactDefinitions(definer(word));
 
-		if (definitions.size() > 0)
+		if (!definitions.empty())
 		{
 			defined = true;
 		}
@@ -44,11 +79,32 @@ void dictionary_creator::Entry::increment_counter(size_t i) noexcept
 	encounters += i;
 }
 
+void dictionary_creator::Entry::set_counter(size_t counter) noexcept
+{
+	encounters = counter;
+}
+
 dictionary_creator::Entry::operator const char *() const noexcept
 {
 	return word.c_str();
 }
 
+std::shared_ptr<dictionary_creator::Entry> dictionary_creator::Entry::clone() const
+{
+	if (typeid(*this) != typeid(dictionary_creator::Entry))
+	{
+		return nullptr;
+	}
+
+	return std::make_shared<dictionary_creator::Entry>(*this);
+}
+
+void dictionary_creator::Entry::refresh_word_metrics()
+{
+	sort_key = collation_key(word);
+	length = utf8_length(word);
+}
+
 dictionary_creator::Entry::~Entry() = default;
 
 /*
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "dictionary_types.h"
+#include "compact_definitions.h"
+#include "definitions_section.h"
+
+#include <memory>
 
 #ifndef BOOST_UNAVAILABLE
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/version.hpp>
 #endif
 
 namespace dictionary_creator
@@ -14,19 +19,39 @@ namespace dictionary_creator
 		explicit Entry(utf8_string word = utf8_string{ "-" });
 
 		utf8_string get_word() const noexcept;
-		const definitions_t &get_definitions() const noexcept;
+		const utf8_string &get_sort_key() const noexcept;
+		// number of UTF-8 characters of the word, counted once along with its sort key
+		size_t get_length() const noexcept;
+		// definitions_t assembled from the compact form on every call, prefer get_compact_definitions() in loops;
+		// definitions kept apart are read from their DefinitionsSection here
+		definitions_t get_definitions() const;
+		// empty for definitions kept apart, they are only reached through get_definitions()
+		const CompactDefinitions &get_compact_definitions() const noexcept;
+		// number of (part of speech, meaning) pairs, parts of speech without meanings add none;
+		// known without reading definitions kept apart
+		size_t count_definitions() const noexcept;
+		bool has_definitions_apart() const noexcept;
 
 		bool is_defined() const noexcept;
 		const Entry &define(const definer_t &definer);
 
 		size_t get_counter() const noexcept;
 		void increment_counter(size_t i = 1) noexcept;
+		void set_counter(size_t counter) noexcept;
 
 		operator const char *() const noexcept;
+
+		// copy used by a Dictionary before changing an entry it shares with another one;
+		// entries of derived types can't be copied here and yield nullptr unless they override it
+		virtual std::shared_ptr<Entry> clone() const;
+
 		virtual ~Entry();
 	private:
 		utf8_string word;
-		definitions_t definitions;
+		utf8_string sort_key;
+		size_t length;
+		CompactDefinitions definitions;
+		std::shared_ptr<const DefinitionsLocation> apart;
 		size_t encounters;
 		bool defined;
 
@@ -38,9 +63,79 @@ namespace dictionary_creator
 		void serialize(A &arch,[[ maybe_unused ]] const unsigned int version)
 		{
 			arch & word;
-			arch & definitions;
+
+			// archived as definitions_t, the layout they always had, unless the archive carries a section to keep them apart in;
+			// version 0 archives know only the former
+			if constexpr (A::is_loading::value)
+			{
+				bool kept_apart = false;
+				if (version > 0)
+				{
+					arch & kept_apart;
+				}
+
+				if (kept_apart)
+				{
+					DefinitionsLocation location{ arch.template get_helper<DefinitionsArchiveHelper>(DefinitionsArchiveHelper::key()).section, 0, 0 };
+					arch & location.record;
+					arch & location.count;
+
+					if (!location.section)
+					{
+						throw dictionary_runtime_error("definitions are kept apart, but their section wasn't given");
+					}
+
+					definitions = CompactDefinitions();
+					apart = std::make_shared<const DefinitionsLocation>(std::move(location));
+				}
+				else
+				{
+					definitions_t loaded;
+					arch & loaded;
+					definitions = CompactDefinitions(loaded);
+					apart.reset();
+				}
+			}
+			else
+			{
+				auto &helper = arch.template get_helper<DefinitionsArchiveHelper>(DefinitionsArchiveHelper::key());
+				const auto &section = helper.section;
+
+				bool kept_apart = section && count_definitions() != 0;
+				arch & kept_apart;
+
+				if (kept_apart)
+				{
+					auto record = section->append(get_definitions());
+					if (apart)
+					{
+						helper.moved.push_back({ apart->section, apart->record, record });
+					}
+
+					auto count = static_cast<uint32_t>(count_definitions());
+					arch & record;
+					arch & count;
+				}
+				else
+				{
+					const definitions_t expanded = get_definitions();
+					arch & expanded;
+				}
+			}
+
 			arch & encounters;
 			arch & defined;
+
+			if constexpr (A::is_loading::value)
+			{
+				refresh_word_metrics();
+			}
 		}
+
+		void refresh_word_metrics();
 	};
 }
+
+#ifndef BOOST_UNAVAILABLE
+BOOST_CLASS_VERSION(dictionary_creator::Entry, 1)
+#endif
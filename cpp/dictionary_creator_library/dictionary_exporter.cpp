@@ -98,7 +98,7 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 
 			if (options & dictionary_creator::ExportOptions::Length)
 			{
-				*output_stream << " (" << dictionary_creator::utf8_length(entry.get_word()) << ")";
+				*output_stream << " (" << entry.get_length() << ")";
 			}
 			if (options & dictionary_creator::ExportOptions::Frequency)
 			{
@@ -117,10 +117,15 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 	}
 	else
 	{
+		// get_definitions() assembles a fresh definitions_t, so it is asked for once per entry and only when printed
+		const auto entry_definitions = (options & (ExportOptions::Ambiguousness | ExportOptions::OnlyOneDefinition | ExportOptions::EveryPartOfSpeech))
+			? entry.get_definitions()
+			: dictionary_creator::definitions_t{};
+
 		*output_stream << entry;
 		if (options & dictionary_creator::ExportOptions::Length)
 		{
-			*output_stream << " (" << dictionary_creator::utf8_length(entry.get_word()) << ")";
+			*output_stream << " (" << entry.get_length() << ")";
 		}
 		if (options & dictionary_creator::ExportOptions::Frequency)
 		{
@@ -129,7 +134,7 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 		if (options & dictionary_creator::ExportOptions::Ambiguousness)
 		{
 			size_t total_definitions = 0;
-			for (const auto& [part_of_speech, definitions] : entry.get_definitions())
+			for (const auto& [part_of_speech, definitions] : entry_definitions)
 			{
 				for (const auto& def : definitions)
 				{
@@ -143,7 +148,7 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 		{
 			if (options & ExportOptions::OnlyOneDefinition)
 			{
-				auto first_definition = entry.get_definitions().begin()->second.begin();
+				auto first_definition = entry_definitions.begin()->second.begin();
 				*output_stream << u8" \U00002014 " << *first_definition;
 			}
 		}
@@ -154,11 +159,11 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 				if (options & ExportOptions::NumberedList)
 				{
 					size_t i = 1;
-					for (const auto& [part, definitions] : entry.get_definitions())
+					for (const auto& [part, definitions] : entry_definitions)
 					{
 						*output_stream << "\t\t";
 
-						if (entry.get_definitions().size() > 1)
+						if (entry_definitions.size() > 1)
 						{
 							*output_stream << i << ". ";
 							++i;
@@ -168,7 +173,7 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 				}
 				else
 				{
-					for (const auto& [part, definitions] : entry.get_definitions())
+					for (const auto& [part, definitions] : entry_definitions)
 					{
 						if (options & ExportOptions::DashedList)
 						{
@@ -183,12 +188,12 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 				if (options & ExportOptions::NumberedList)
 				{
 					size_t i = 1;
-					for (const auto& [part, definitions] : entry.get_definitions())
+					for (const auto& [part, definitions] : entry_definitions)
 					{
 						for (const auto& d : definitions)
 						{
 							*output_stream << "\t\t";
-							if (entry.get_definitions().size() > 1 || entry.get_definitions().begin()->second.size() > 1)
+							if (entry_definitions.size() > 1 || entry_definitions.begin()->second.size() > 1)
 							{
 								*output_stream << i << ". ";
 								++i;
@@ -199,7 +204,7 @@ void dictionary_creator::DictionaryExporter::print_entry(const dictionary_creato
 				}
 				else if (options & ExportOptions::DashedList)
 				{
-					for (const auto& [part, definitions] : entry.get_definitions())
+					for (const auto& [part, definitions] : entry_definitions)
 					{
 						for (const auto& d : definitions)
 						{
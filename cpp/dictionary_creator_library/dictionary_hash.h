@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Non-cryptographic hashing shared by the read-optimized structures built on top of Dictionary.
+// It is deliberately independent of std::hash so that its values are stable between runs and platforms:
+// bytes are read into 64-bit chunks in little-endian order whatever the byte order of the host is.
+
+namespace dictionary_creator
+{
+	inline uint64_t mix_hash(uint64_t value) noexcept
+	{
+		value ^= value >> 33;
+		value *= 0xFF51AFD7ED558CCDull;
+		value ^= value >> 33;
+		value *= 0xC4CEB9FE1A85EC53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+	// up to eight bytes, the first of them the least significant one
+	inline uint64_t little_endian_chunk(const char *data, size_t size) noexcept
+	{
+		const auto byte = [data] (size_t i) { return static_cast<uint64_t>(static_cast<unsigned char>(data[i])); };
+
+		// spelled out, a full chunk compiles to a single load on little-endian hosts
+		if (size == sizeof(uint64_t))
+		{
+			return byte(0) | byte(1) << 8 | byte(2) << 16 | byte(3) << 24
+				| byte(4) << 32 | byte(5) << 40 | byte(6) << 48 | byte(7) << 56;
+		}
+
+		uint64_t chunk = 0;
+		for (size_t i = 0; i != size; ++i)
+		{
+			chunk |= byte(i) << (8 * i);
+		}
+		return chunk;
+	}
+
+	inline uint64_t hash_bytes(std::string_view bytes, uint64_t seed = 0) noexcept
+	{
+		constexpr uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+
+		uint64_t result = seed ^ (bytes.size() * multiplier);
+		const char *data = bytes.data();
+		size_t remaining = bytes.size();
+
+		while (remaining >= sizeof(uint64_t))
+		{
+			result = (result ^ mix_hash(little_endian_chunk(data, sizeof(uint64_t)))) * multiplier;
+
+			data += sizeof(uint64_t);
+			remaining -= sizeof(uint64_t);
+		}
+
+		if (remaining != 0)
+		{
+			result = (result ^ mix_hash(little_endian_chunk(data, remaining))) * multiplier;
+		}
+
+		return mix_hash(result);
+	}
+}
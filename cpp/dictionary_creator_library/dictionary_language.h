@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <locale>
 #include <exception>
+#include <stdexcept>
+#include <optional>
 #include <array>
 
 #include "dictionary_types.h"
@@ -62,6 +66,196 @@ namespace dictionary_creator
 		return separate_characters;
 	}
 
+	namespace collation
+	{
+		struct Element
+		{
+			std::string_view primary;
+			char secondary;
+			char tertiary;
+		};
+
+		constexpr char separator = '\x01';
+		constexpr char lowercase = '\x05', uppercase = '\x06';
+		constexpr char plain = '\x05', acute = '\x06', grave = '\x07', circumflex = '\x08', ring = '\x09',
+			diaeresis = '\x0A', tilde = '\x0B', cedilla = '\x0C', stroke = '\x0D', ligature = '\x0E';
+
+		constexpr std::string_view ascii_weights{ "0123456789abcdefghijklmnopqrstuvwxyz" };
+
+		// а to я are weighted 0x80 to 0x9F in alphabetical order, so that they follow latin letters
+		constexpr std::string_view cyrillic_weights{ "\x80\x81\x82\x83\x84\x85\x86\x87\x88\x89\x8A\x8B\x8C\x8D\x8E\x8F"
+			"\x90\x91\x92\x93\x94\x95\x96\x97\x98\x99\x9A\x9B\x9C\x9D\x9E\x9F" };
+
+		// U+00E0 to U+00FF, capitals U+00C0 to U+00DE are mapped onto the same elements
+		constexpr std::array<std::pair<std::string_view, char>, 32> latin_1
+		{ {
+			{ "a", grave }, { "a", acute }, { "a", circumflex }, { "a", tilde }, { "a", diaeresis }, { "a", ring }, { "ae", ligature }, { "c", cedilla },
+			{ "e", grave }, { "e", acute }, { "e", circumflex }, { "e", diaeresis }, { "i", grave }, { "i", acute }, { "i", circumflex }, { "i", diaeresis },
+			{ "d", stroke }, { "n", tilde }, { "o", grave }, { "o", acute }, { "o", circumflex }, { "o", tilde }, { "o", diaeresis }, { "", plain },
+			{ "o", stroke }, { "u", grave }, { "u", acute }, { "u", circumflex }, { "u", diaeresis }, { "y", acute }, { "", plain }, { "y", diaeresis }
+		} };
+
+		// Collation element of the code point starting at position, which is advanced past that code point.
+		// Punctuation inside of words such as hyphens and apostrophes is ignorable and yields an empty primary weight.
+		inline Element next_element(std::string_view word, size_t &position) noexcept
+		{
+			const auto lead = static_cast<unsigned char>(word[position]);
+
+			if (lead < 0x80)
+			{
+				++position;
+
+				if ('0' <= lead && lead <= '9')
+				{
+					return { ascii_weights.substr(lead - '0', 1), plain, lowercase };
+				}
+				else if ('a' <= lead && lead <= 'z')
+				{
+					return { ascii_weights.substr(lead - 'a' + 10, 1), plain, lowercase };
+				}
+				else if ('A' <= lead && lead <= 'Z')
+				{
+					return { ascii_weights.substr(lead - 'A' + 10, 1), plain, uppercase };
+				}
+				return { std::string_view{}, plain, lowercase };
+			}
+
+			const size_t expected = (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 0;
+			const size_t length = (expected != 0 && expected <= word.size() - position) ? expected : 1;
+
+			char32_t code = 0xFFFD;
+			if (length == expected)
+			{
+				code = lead & (0x7F >> length);
+				for (size_t i = 1; i < length; ++i)
+				{
+					code = (code << 6) | (static_cast<unsigned char>(word[position + i]) & 0x3F);
+				}
+			}
+
+			const auto raw = word.substr(position, length);
+			position += length;
+
+			if (code == 0xDF || code == 0x1E9E)
+			{
+				return { "ss", ligature, code == 0xDF ? lowercase : uppercase };
+			}
+			else if (0xC0 <= code && code <= 0xFF && !latin_1[code & 0x1F].first.empty())
+			{
+				const auto &[base, accent] = latin_1[code & 0x1F];
+				return { base, accent, code >= 0xE0 ? lowercase : uppercase };
+			}
+			else if (code == 0x152 || code == 0x153)
+			{
+				return { "oe", ligature, code == 0x153 ? lowercase : uppercase };
+			}
+			else if (code == 0x178)
+			{
+				return { "y", diaeresis, uppercase };
+			}
+			else if (0x410 <= code && code <= 0x44F)
+			{
+				return { cyrillic_weights.substr((code - 0x410) & 0x1F, 1), plain, code >= 0x430 ? lowercase : uppercase };
+			}
+			else if (code == 0x401 || code == 0x451)
+			{
+				return { cyrillic_weights.substr(5, 1), diaeresis, code == 0x451 ? lowercase : uppercase };
+			}
+
+			return { raw, plain, lowercase };
+		}
+
+		inline void trim_trailing(utf8_string &level, char default_weight)
+		{
+			while (!level.empty() && level.back() == default_weight)
+			{
+				level.pop_back();
+			}
+		}
+	}
+
+	// Multilevel sort key in the spirit of ISO 14651: base letters, then diacritics, then case.
+	// Plain byte comparison of two keys yields the dictionary order: cote < coté < côte, ежевика < ёжик < жесть.
+	// Latin and Cyrillic alphabets of all the supported languages share one table, as they do in glibc locales.
+	inline utf8_string collation_key(const utf8_string &word)
+	{
+		bool only_lowercase_ascii = true;
+		for (auto character: word)
+		{
+			if (!(('a' <= character && character <= 'z') || ('0' <= character && character <= '9')))
+			{
+				only_lowercase_ascii = false;
+				break;
+			}
+		}
+
+		if (only_lowercase_ascii)
+		{
+			return word;
+		}
+
+		utf8_string primary, secondary, tertiary;
+		primary.reserve(word.size());
+
+		for (size_t position = 0; position < word.size(); )
+		{
+			if (auto element = collation::next_element(word, position); !element.primary.empty())
+			{
+				primary.append(element.primary);
+				secondary.push_back(element.secondary);
+				tertiary.push_back(element.tertiary);
+			}
+		}
+
+		collation::trim_trailing(secondary, collation::plain);
+		collation::trim_trailing(tertiary, collation::lowercase);
+
+		utf8_string key = std::move(primary);
+		key.push_back(collation::separator);
+		key += secondary;
+		key.push_back(collation::separator);
+		key += tertiary;
+
+		collation::trim_trailing(key, collation::separator);
+
+		return key;
+	}
+
+	inline bool collation_less(const utf8_string &a, const utf8_string &b)
+	{
+		size_t a_position = 0;
+		size_t b_position = 0;
+
+		if (!a.empty() && !b.empty())
+		{
+			const auto a_element = collation::next_element(a, a_position);
+			const auto b_element = collation::next_element(b, b_position);
+
+			// single code points such as first letters are compared level by level without building the keys
+			if (a_position == a.size() && b_position == b.size())
+			{
+				if (a_element.primary != b_element.primary)
+				{
+					return a_element.primary < b_element.primary;
+				}
+				else if (a_element.secondary != b_element.secondary)
+				{
+					return a_element.secondary < b_element.secondary;
+				}
+				else if (a_element.tertiary != b_element.tertiary)
+				{
+					return a_element.tertiary < b_element.tertiary;
+				}
+				return a < b;
+			}
+		}
+
+		const auto a_key = collation_key(a);
+		const auto b_key = collation_key(b);
+
+		return a_key != b_key ? a_key < b_key : a < b;
+	}
+
 	inline letter_type first_letter(const utf8_string &word, Language language)
 	{
 		letter_type first_letter{ word.front() };
@@ -84,7 +278,8 @@ namespace dictionary_creator
 		return first_letter;
 	}
 
-	inline letter_type uppercase_letter(letter_type letter, Language language)
+	// nullopt for a letter that is no valid UTF-8 letter of the language, so that probing words needs no exceptions
+	inline std::optional<letter_type> try_uppercase_letter(letter_type letter, Language language)
 	{
 		switch (language)
 		{
@@ -96,7 +291,7 @@ namespace dictionary_creator
 			{
 				if (letter.size() > 2)
 				{
-					throw std::runtime_error("broken UTF-8 letter");
+					return std::nullopt;
 				}
 
 				if (letter.size() == 1)
@@ -128,7 +323,7 @@ namespace dictionary_creator
 			{
 				if (letter.size() != 2)
 				{
-					throw std::runtime_error("broken UTF-8 letter");
+					return std::nullopt;
 				}
 
 				size_t code = ((letter[0] & 0x1F) << 6) | (letter[1] & 0x3F);
@@ -157,7 +352,7 @@ namespace dictionary_creator
 					}
 					else
 					{
-						throw std::runtime_error("broken UTF-8 letter");
+						return std::nullopt;
 					}
 				}
 
@@ -195,8 +390,23 @@ namespace dictionary_creator
 				return letter;
 			}
 		default:
+			return std::nullopt;
+		}
+	}
+
+	inline letter_type uppercase_letter(letter_type letter, Language language)
+	{
+		if (language == Language::Uninitialized || language > Language::German)
+		{
 			throw std::runtime_error("Language is not supported");
 		}
+
+		if (auto uppercase = try_uppercase_letter(std::move(letter), language); uppercase)
+		{
+			return *std::move(uppercase);
+		}
+
+		throw std::runtime_error("broken UTF-8 letter");
 	}
 
 	const std::vector<std::string> language_codes
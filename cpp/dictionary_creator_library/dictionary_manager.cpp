@@ -11,6 +11,53 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/serialization/export.hpp>
+
+#include <map>
+#include <unordered_map>
+
+namespace
+{
+	// sections entries of an earlier load read from let go of the replaced file, then follow their records into the new one;
+	// sections of other loads of the same file, which no saved entry came from, keep it open
+	void replace_definitions(const std::filesystem::path &written, const std::filesystem::path &replaced,
+		const std::vector<dictionary_creator::DefinitionsArchiveHelper::Moved> &moved)
+	{
+		using records_t = std::unordered_map<dictionary_creator::DefinitionsSection::record_type, dictionary_creator::DefinitionsSection::record_type>;
+		std::map<std::shared_ptr<dictionary_creator::DefinitionsSection>, records_t> sections;
+
+		for (const auto &[from, record, written_record]: moved)
+		{
+			std::error_code ignored;
+			if (std::filesystem::equivalent(from->get_path(), replaced, ignored))
+			{
+				sections[from].emplace(record, written_record);
+			}
+		}
+
+		for (const auto &[section, records]: sections)
+		{
+			section->release();
+		}
+
+		try
+		{
+			std::filesystem::rename(written, replaced);
+		}
+		catch (...)
+		{
+			for (const auto &[section, records]: sections)
+			{
+				section->reopen();
+			}
+			throw;
+		}
+
+		for (auto &[section, records]: sections)
+		{
+			section->relocate(replaced, std::move(records));
+		}
+	}
+}
 #endif // BOOST_UNAVAILABLE
 
 
@@ -93,6 +140,27 @@ dictionary_creator::subset_t dictionary_creator::DictionaryManager::get_subset(d
 	return res;
 }
 
+dictionary_creator::subset_t dictionary_creator::DictionaryManager::get_completions(dictionary_creator::utf8_string prefix, size_t number)
+{
+	dictionary.enable_prefix_index();
+
+	return dictionary.get_completions(std::move(prefix), number);
+}
+
+dictionary_creator::subset_t dictionary_creator::DictionaryManager::get_suggestions(dictionary_creator::utf8_string word, size_t number, size_t distance)
+{
+	dictionary.enable_fuzzy_index(distance);
+
+	return dictionary.get_suggestions(std::move(word), number, distance);
+}
+
+dictionary_creator::WordSketch dictionary_creator::DictionaryManager::get_word_sketch()
+{
+	dictionary.enable_word_sketch();
+
+	return dictionary.get_word_sketch();
+}
+
 dictionary_creator::subset_t dictionary_creator::DictionaryManager::get_undefined(size_t number) const
 {
 	auto res = dictionary.get_undefined();
@@ -198,20 +266,66 @@ dictionary_creator::utf8_string dictionary_creator::DictionaryManager::get_name(
 	return name;
 }
 
-void dictionary_creator::DictionaryManager::save_dictionary() const
+void dictionary_creator::DictionaryManager::save_dictionary([[ maybe_unused ]] dictionary_creator::DefinitionsStorage storage) const
 {
 	if (std::filesystem::exists(dictionaries_directory) == false && std::filesystem::create_directory(dictionaries_directory) == false)
 	{
 		throw std::runtime_error("Saving dictionaries is unavailable");
 	}
 
-	std::ofstream output(dictionary_creator::utf8_string{ dictionaries_directory } + u8"/" + name + dictionaries_extension);
+	const std::filesystem::path file_name = dictionary_creator::utf8_string{ dictionaries_directory } + u8"/" + name + dictionaries_extension;
+	const auto definitions_file = std::filesystem::path(file_name).replace_extension(definitions_extension);
+	const auto sketch_file = std::filesystem::path(file_name).replace_extension(sketch_extension);
+
+	std::ofstream output(file_name);
 #ifndef BOOST_UNAVAILABLE
 	if (output.good())
 	{
-		boost::archive::text_oarchive oa(output);
-		oa & name;
-		oa & dictionary;
+		// written aside first, entries loaded from the previous section may still be reading it until it's replaced
+		auto definitions_partial = definitions_file;
+		definitions_partial += ".partial";
+
+		std::shared_ptr<dictionary_creator::DefinitionsSection> section;
+		if (storage == dictionary_creator::DefinitionsStorage::Apart)
+		{
+			section = dictionary_creator::DefinitionsSection::create(definitions_partial);
+		}
+
+		std::vector<dictionary_creator::DefinitionsArchiveHelper::Moved> moved;
+		{
+			boost::archive::text_oarchive oa(output);
+			auto &helper = oa.get_helper<dictionary_creator::DefinitionsArchiveHelper>(dictionary_creator::DefinitionsArchiveHelper::key());
+			helper.section = section;
+			oa & name;
+			oa & dictionary;
+			moved = std::move(helper.moved);
+		}
+
+		if (section)
+		{
+			section->finish();
+			replace_definitions(definitions_partial, definitions_file, moved);
+		}
+		else
+		{
+			std::error_code ignored;
+			std::filesystem::remove(definitions_file, ignored);
+		}
+
+		// kept apart, so that comparing against many saved dictionaries reads a few kilobytes of each
+		std::ofstream sketch_output(sketch_file, std::ios::binary | std::ios::trunc);
+		if (!sketch_output.good())
+		{
+			throw std::runtime_error("Saving failed, couldn't write the word sketch");
+		}
+
+		dictionary.get_word_sketch().write(sketch_output);
+
+		sketch_output.close();
+		if (sketch_output.fail())
+		{
+			throw std::runtime_error("Saving failed, couldn't write the word sketch");
+		}
 	}
 	else
 #endif // BOOST_UNAVAILABLE
@@ -221,7 +335,7 @@ void dictionary_creator::DictionaryManager::save_dictionary() const
 #ifdef _WIN32
 #pragma warning(disable: 4702)
 #endif
-dictionary_creator::DictionaryManager dictionary_creator::load_dictionary([[ maybe_unused ]] dictionary_creator::utf8_string file_name)
+dictionary_creator::DictionaryManager dictionary_creator::load_dictionary([[ maybe_unused ]] dictionary_creator::utf8_string file_name, [[ maybe_unused ]] size_t resident_definitions)
 {
 	dictionary_creator::Dictionary acquired_dictionary(dictionary_creator::Language::Uninitialized);
 
@@ -231,6 +345,13 @@ dictionary_creator::DictionaryManager dictionary_creator::load_dictionary([[ may
 	if (std::ifstream stream(file_name); stream.good())
 	{
 		boost::archive::text_iarchive ia(stream);
+
+		if (auto definitions_file = std::filesystem::path(file_name).replace_extension(dictionary_creator::DictionaryManager::definitions_extension);
+				std::filesystem::exists(definitions_file))
+		{
+			ia.get_helper<dictionary_creator::DefinitionsArchiveHelper>(dictionary_creator::DefinitionsArchiveHelper::key()).section = dictionary_creator::DefinitionsSection::open(definitions_file, resident_definitions);
+		}
+
 		ia & acquired_name;
 		ia & acquired_dictionary;
 	}
@@ -245,6 +366,19 @@ dictionary_creator::DictionaryManager dictionary_creator::load_dictionary([[ may
 	return result;
 }
 
+dictionary_creator::WordSketch dictionary_creator::load_word_sketch(dictionary_creator::utf8_string file_name)
+{
+	const auto sketch_file = std::filesystem::path(file_name).replace_extension(dictionary_creator::DictionaryManager::sketch_extension);
+
+	std::ifstream stream(sketch_file, std::ios::binary);
+	if (!stream.good())
+	{
+		throw std::runtime_error("Failed to read the word sketch");
+	}
+
+	return dictionary_creator::WordSketch::read(stream);
+}
+
 std::vector<dictionary_creator::dictionary_filename> dictionary_creator::available_dictionaries()
 {
 	std::vector<dictionary_creator::dictionary_filename> result;
@@ -21,7 +21,10 @@ namespace dictionary_creator
 
 	class DictionaryManager;
 
-	DictionaryManager load_dictionary(utf8_string file_name);
+	// definitions saved apart are read on demand, at most resident_definitions entries' worth of them stay in memory
+	DictionaryManager load_dictionary(utf8_string file_name, size_t resident_definitions = DefinitionsSection::default_resident_limit);
+	// the word sketch saved next to the dictionary, read without loading the dictionary itself
+	WordSketch load_word_sketch(utf8_string file_name);
 	std::vector<dictionary_filename> available_dictionaries();
 
 	class DictionaryManager
@@ -52,12 +55,16 @@ namespace dictionary_creator
 		subset_t get_subset(ComparisonType criterion, size_t number) const;
 		subset_t get_subset(letter_type letter, size_t number = 0) const;
 
+		// the comparator reaches Dictionary::get_top<T>() as it is, T is the type both its parameters refer to
 		template <typename Comparator>
 		subset_t get_subset(Comparator &&comparator, size_t number) const
 		{
-			return dictionary.get_top(std::function(std::forward<Comparator>(comparator)), number);
+			return dictionary.get_top<compared_type_t<Comparator>>(std::forward<Comparator>(comparator), number);
 		}
 
+		subset_t get_completions(utf8_string prefix, size_t number);
+		subset_t get_suggestions(utf8_string word, size_t number, size_t distance = 2);
+		WordSketch get_word_sketch();
 		subset_t get_undefined(size_t number = 0) const;
 		std::shared_ptr<Entry> get_random_word() const;
 		subset_t get_random_words(size_t number) const;
@@ -75,8 +82,10 @@ namespace dictionary_creator
 
 		void rename(utf8_string new_name);
 		utf8_string get_name() const noexcept;
-		void save_dictionary() const;
-		friend DictionaryManager load_dictionary(utf8_string file_name);
+		// DefinitionsStorage::Apart writes the definitions to a file of their own next to the dictionary
+		void save_dictionary(DefinitionsStorage storage = DefinitionsStorage::Inline) const;
+		friend DictionaryManager load_dictionary(utf8_string file_name, size_t resident_definitions);
+		friend WordSketch load_word_sketch(utf8_string file_name);
 		friend std::vector<dictionary_filename> available_dictionaries();
 
 	private:
@@ -88,5 +97,7 @@ namespace dictionary_creator
 
 		static constexpr auto dictionaries_directory = "Saved dictionaries";
 		static constexpr auto dictionaries_extension = ".dic";
+		static constexpr auto definitions_extension = ".dfn";
+		static constexpr auto sketch_extension = ".skt";
 	};
 }
@@ -0,0 +1,218 @@
+#include "frozen_dictionary.h"
+
+#include "dictionary_hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	constexpr size_t keys_per_bucket = 2;
+	constexpr uint32_t maximal_displacement = 1u << 20;
+	constexpr uint64_t maximal_seeds = 8;
+}
+
+dictionary_creator::FrozenDictionary::FrozenDictionary(dictionary_creator::Language language,
+		const std::vector<std::shared_ptr<dictionary_creator::Entry>> &entries)
+	: language{ language }, seed{ 0 }, table_size{ 0 }
+{
+	if (entries.size() >= direct_slot_flag)
+	{
+		throw dictionary_creator::dictionary_runtime_error("too many words to freeze the dictionary");
+	}
+
+	while (!build(entries))
+	{
+		if (++seed == maximal_seeds)
+		{
+			throw dictionary_creator::dictionary_runtime_error("failed to freeze the dictionary, are all the words unique?");
+		}
+	}
+}
+
+bool dictionary_creator::FrozenDictionary::build(const std::vector<std::shared_ptr<dictionary_creator::Entry>> &source)
+{
+	const size_t total = source.size();
+	table_size = total;
+
+	std::vector<uint64_t> hashes;
+	hashes.reserve(total);
+	for (const auto &entry: source)
+	{
+		hashes.push_back(dictionary_creator::hash_bytes(static_cast<const char *>(*entry), seed));
+	}
+
+	displacements.assign(std::max<size_t>(1, (total + keys_per_bucket - 1) / keys_per_bucket), 0);
+
+	std::vector<std::vector<uint32_t>> buckets(displacements.size());
+	for (size_t i = 0; i != total; ++i)
+	{
+		buckets[bucket_of(hashes[i])].push_back(static_cast<uint32_t>(i));
+	}
+
+	std::vector<uint32_t> order(buckets.size());
+	for (size_t i = 0; i != order.size(); ++i)
+	{
+		order[i] = static_cast<uint32_t>(i);
+	}
+	std::stable_sort(order.begin(), order.end(),
+			[&buckets] (uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+	constexpr uint32_t vacant = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> placement(total, vacant);
+	std::vector<size_t> candidate_slots;
+	size_t next_free_slot = 0;
+
+	for (auto bucket: order)
+	{
+		const auto &members = buckets[bucket];
+
+		if (members.empty())
+		{
+			break;
+		}
+		else if (members.size() == 1)
+		{
+			while (placement[next_free_slot] != vacant)
+			{
+				++next_free_slot;
+			}
+
+			placement[next_free_slot] = members.front();
+			displacements[bucket] = direct_slot_flag | static_cast<uint32_t>(next_free_slot);
+			continue;
+		}
+
+		uint32_t displacement = 1;
+		for (; displacement != maximal_displacement; ++displacement)
+		{
+			candidate_slots.clear();
+
+			bool fits = true;
+			for (auto member: members)
+			{
+				size_t slot = slot_of(hashes[member], displacement);
+
+				if (placement[slot] != vacant
+					|| std::find(candidate_slots.begin(), candidate_slots.end(), slot) != candidate_slots.end())
+				{
+					fits = false;
+					break;
+				}
+
+				candidate_slots.push_back(slot);
+			}
+
+			if (fits)
+			{
+				break;
+			}
+		}
+
+		if (displacement == maximal_displacement)
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i != members.size(); ++i)
+		{
+			placement[candidate_slots[i]] = members[i];
+		}
+		displacements[bucket] = displacement;
+	}
+
+	slots.clear();
+	slots.reserve(total);
+	counters.clear();
+	counters.reserve(total);
+	entries.clear();
+	entries.reserve(total);
+	words.clear();
+
+	for (auto index: placement)
+	{
+		const auto &entry = source[index];
+		const char *word = *entry;
+		const size_t length = std::strlen(word);
+
+		if (words.size() + length > std::numeric_limits<uint32_t>::max())
+		{
+			throw dictionary_creator::dictionary_runtime_error("frozen dictionary words exceed the addressable size");
+		}
+
+		slots.push_back(Slot{ hashes[index], static_cast<uint32_t>(words.size()), static_cast<uint32_t>(length) });
+		words.append(word, length);
+		counters.push_back(entry->get_counter());
+		entries.push_back(entry);
+	}
+
+	return true;
+}
+
+size_t dictionary_creator::FrozenDictionary::bucket_of(uint64_t hash) const noexcept
+{
+	return static_cast<size_t>(((hash >> 32) * displacements.size()) >> 32);
+}
+
+size_t dictionary_creator::FrozenDictionary::slot_of(uint64_t hash, uint32_t displacement) const noexcept
+{
+	const uint64_t mixed = dictionary_creator::mix_hash(hash + displacement) & 0xFFFFFFFFull;
+	return static_cast<size_t>((mixed * table_size) >> 32);
+}
+
+size_t dictionary_creator::FrozenDictionary::find(std::string_view word) const noexcept
+{
+	if (slots.empty())
+	{
+		return npos;
+	}
+
+	const uint64_t hash = dictionary_creator::hash_bytes(word, seed);
+	const uint32_t displacement = displacements[bucket_of(hash)];
+	const size_t slot = (displacement & direct_slot_flag) ? (displacement & ~direct_slot_flag) : slot_of(hash, displacement);
+
+	const auto &candidate = slots[slot];
+	if (candidate.hash == hash && candidate.length == word.size()
+		&& std::memcmp(words.data() + candidate.offset, word.data(), word.size()) == 0)
+	{
+		return slot;
+	}
+
+	return npos;
+}
+
+bool dictionary_creator::FrozenDictionary::contains_word(std::string_view word) const noexcept
+{
+	return find(word) != npos;
+}
+
+const dictionary_creator::Entry *dictionary_creator::FrozenDictionary::lookup(std::string_view word) const noexcept
+{
+	if (auto slot = find(word); slot != npos)
+	{
+		return entries[slot].get();
+	}
+
+	return nullptr;
+}
+
+size_t dictionary_creator::FrozenDictionary::get_counter(std::string_view word) const noexcept
+{
+	if (auto slot = find(word); slot != npos)
+	{
+		return counters[slot];
+	}
+
+	return 0;
+}
+
+size_t dictionary_creator::FrozenDictionary::total_words() const noexcept
+{
+	return slots.size();
+}
+
+dictionary_creator::Language dictionary_creator::FrozenDictionary::get_language() const noexcept
+{
+	return language;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "dictionary_types.h"
+#include "dictionary_entry.h"
+#include "dictionary_language.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Immutable snapshot of a Dictionary for lookup-heavy serving, produced by Dictionary::freeze().
+//
+// 	-- words are addressed through a minimal perfect hash (hash and displace), so a lookup is a hash,
+// 	   one displacement read, and a single candidate comparison with no tree walk and no exceptions
+// 	-- all words live in one contiguous blob, slots and counters are laid out in the same order
+// 	-- counters are captured at freeze time; entries are shared with the origin for definitions access
+
+namespace dictionary_creator
+{
+	class FrozenDictionary
+	{
+	public:
+		FrozenDictionary(Language language, const std::vector<std::shared_ptr<Entry>> &entries);
+
+		bool contains_word(std::string_view word) const noexcept;
+		const Entry *lookup(std::string_view word) const noexcept;
+		size_t get_counter(std::string_view word) const noexcept;
+
+		size_t total_words() const noexcept;
+		Language get_language() const noexcept;
+
+	private:
+		struct Slot
+		{
+			uint64_t hash;
+			uint32_t offset;
+			uint32_t length;
+		};
+
+		static constexpr size_t npos = static_cast<size_t>(-1);
+		static constexpr uint32_t direct_slot_flag = 0x80000000u;
+
+		size_t find(std::string_view word) const noexcept;
+		size_t bucket_of(uint64_t hash) const noexcept;
+		size_t slot_of(uint64_t hash, uint32_t displacement) const noexcept;
+		bool build(const std::vector<std::shared_ptr<Entry>> &entries);
+
+		Language language;
+		uint64_t seed;
+		size_t table_size;
+		std::vector<uint32_t> displacements;
+		std::vector<Slot> slots;
+		std::string words;
+		std::vector<size_t> counters;
+		std::vector<std::shared_ptr<Entry>> entries;
+	};
+}
@@ -0,0 +1,224 @@
+#include "fuzzy_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <unordered_set>
+
+namespace
+{
+	std::vector<std::string_view> split_code_points(std::string_view word)
+	{
+		std::vector<std::string_view> code_points;
+		code_points.reserve(word.size());
+
+		for (size_t begin = 0; begin < word.size(); )
+		{
+			size_t end = begin + 1;
+			while (end < word.size() && (static_cast<unsigned char>(word[end]) & 0xC0) == 0x80)
+			{
+				++end;
+			}
+
+			code_points.push_back(word.substr(begin, end - begin));
+			begin = end;
+		}
+
+		return code_points;
+	}
+}
+
+size_t dictionary_creator::edit_distance(std::string_view a, std::string_view b)
+{
+	const auto first = split_code_points(a);
+	const auto second = split_code_points(b);
+
+	std::vector<size_t> previous(second.size() + 1);
+	std::vector<size_t> current(second.size() + 1);
+	std::iota(previous.begin(), previous.end(), size_t{ 0 });
+
+	for (size_t i = 0; i != first.size(); ++i)
+	{
+		current[0] = i + 1;
+
+		for (size_t j = 0; j != second.size(); ++j)
+		{
+			const size_t substitution = previous[j] + (first[i] == second[j] ? 0 : 1);
+			current[j + 1] = std::min({ substitution, previous[j + 1] + 1, current[j] + 1 });
+		}
+
+		std::swap(previous, current);
+	}
+
+	return previous.back();
+}
+
+dictionary_creator::FuzzyIndex::FuzzyIndex(size_t max_distance)
+	: max_distance{ max_distance }
+{}
+
+std::vector<dictionary_creator::utf8_string> dictionary_creator::FuzzyIndex::deletion_variants(std::string_view word, size_t distance) const
+{
+	std::unordered_set<dictionary_creator::utf8_string> unique{ dictionary_creator::utf8_string{ word } };
+	std::vector<dictionary_creator::utf8_string> level{ dictionary_creator::utf8_string{ word } };
+
+	for (size_t deleted = 0; deleted != distance && !level.empty(); ++deleted)
+	{
+		std::vector<dictionary_creator::utf8_string> next_level;
+
+		for (const auto &variant: level)
+		{
+			size_t offset = 0;
+			for (auto code_point: split_code_points(variant))
+			{
+				auto shorter = variant.substr(0, offset) + variant.substr(offset + code_point.size());
+				offset += code_point.size();
+
+				if (unique.insert(shorter).second)
+				{
+					next_level.push_back(std::move(shorter));
+				}
+			}
+		}
+
+		level = std::move(next_level);
+	}
+
+	return std::vector<dictionary_creator::utf8_string>(unique.begin(), unique.end());
+}
+
+void dictionary_creator::FuzzyIndex::insert(const std::shared_ptr<dictionary_creator::Entry> &entry)
+{
+	dictionary_creator::utf8_string word = static_cast<const char *>(*entry);
+
+	if (auto existing = ids.find(word); existing != ids.end())
+	{
+		entries[existing->second] = entry;
+		return;
+	}
+
+	uint32_t id;
+	if (!vacant_ids.empty())
+	{
+		id = vacant_ids.back();
+		vacant_ids.pop_back();
+		entries[id] = entry;
+	}
+	else
+	{
+		if (entries.size() == std::numeric_limits<uint32_t>::max())
+		{
+			throw dictionary_creator::dictionary_runtime_error("fuzzy index is out of word identifiers");
+		}
+
+		id = static_cast<uint32_t>(entries.size());
+		entries.push_back(entry);
+	}
+
+	for (auto &variant: deletion_variants(word, max_distance))
+	{
+		variants[std::move(variant)].push_back(id);
+	}
+
+	ids.emplace(std::move(word), id);
+}
+
+void dictionary_creator::FuzzyIndex::erase(std::string_view word)
+{
+	auto existing = ids.find(dictionary_creator::utf8_string{ word });
+	if (existing == ids.end())
+	{
+		return;
+	}
+
+	const auto id = existing->second;
+
+	for (const auto &variant: deletion_variants(word, max_distance))
+	{
+		if (auto bucket = variants.find(variant); bucket != variants.end())
+		{
+			auto &candidates = bucket->second;
+			candidates.erase(std::remove(candidates.begin(), candidates.end(), id), candidates.end());
+
+			if (candidates.empty())
+			{
+				variants.erase(bucket);
+			}
+		}
+	}
+
+	entries[id].reset();
+	vacant_ids.push_back(id);
+	ids.erase(existing);
+}
+
+void dictionary_creator::FuzzyIndex::clear()
+{
+	entries.clear();
+	vacant_ids.clear();
+	ids.clear();
+	variants.clear();
+}
+
+std::vector<std::shared_ptr<dictionary_creator::Entry>> dictionary_creator::FuzzyIndex::suggest(std::string_view word,
+		size_t number, size_t distance) const
+{
+	distance = std::min(distance, max_distance);
+
+	std::vector<std::tuple<size_t, size_t, uint32_t>> found;
+	std::unordered_set<uint32_t> checked;
+
+	for (const auto &variant: deletion_variants(word, distance))
+	{
+		auto bucket = variants.find(variant);
+		if (bucket == variants.end())
+		{
+			continue;
+		}
+
+		for (auto id: bucket->second)
+		{
+			if (!checked.insert(id).second)
+			{
+				continue;
+			}
+
+			if (auto current = dictionary_creator::edit_distance(word, static_cast<const char *>(*entries[id])); current <= distance)
+			{
+				found.emplace_back(entries[id]->get_counter(), current, id);
+			}
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [this] (const auto &a, const auto &b)
+		{
+			if (std::get<0>(a) != std::get<0>(b))
+			{
+				return std::get<0>(a) > std::get<0>(b);
+			}
+			else if (std::get<1>(a) != std::get<1>(b))
+			{
+				return std::get<1>(a) < std::get<1>(b);
+			}
+			return entries[std::get<2>(a)]->get_word() < entries[std::get<2>(b)]->get_word();
+		});
+
+	std::vector<std::shared_ptr<dictionary_creator::Entry>> result;
+	for (size_t i = 0; i != found.size() && i != number; ++i)
+	{
+		result.push_back(entries[std::get<2>(found[i])]);
+	}
+
+	return result;
+}
+
+size_t dictionary_creator::FuzzyIndex::get_max_distance() const noexcept
+{
+	return max_distance;
+}
+
+size_t dictionary_creator::FuzzyIndex::total_words() const noexcept
+{
+	return ids.size();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "dictionary_types.h"
+#include "dictionary_entry.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Approximate match index over the entries of one Dictionary, used for "did you mean" suggestions.
+//
+// 	-- symmetric deletion: every word is registered under each of its variants with up to max_distance
+// 	   code points deleted, a query looks its own deletion variants up and verifies the candidates
+// 	-- distances are Levenshtein distances counted in code points, so é or ё is one edit, not two
+// 	-- the index is updated word by word, no rebuild is ever needed
+
+namespace dictionary_creator
+{
+	size_t edit_distance(std::string_view a, std::string_view b);
+
+	class FuzzyIndex
+	{
+	public:
+		explicit FuzzyIndex(size_t max_distance = 2);
+
+		void insert(const std::shared_ptr<Entry> &entry);
+		void erase(std::string_view word);
+		void clear();
+
+		std::vector<std::shared_ptr<Entry>> suggest(std::string_view word, size_t number, size_t distance) const;
+
+		size_t get_max_distance() const noexcept;
+		size_t total_words() const noexcept;
+
+	private:
+		std::vector<utf8_string> deletion_variants(std::string_view word, size_t distance) const;
+
+		size_t max_distance;
+		std::vector<std::shared_ptr<Entry>> entries;
+		std::vector<uint32_t> vacant_ids;
+		std::unordered_map<utf8_string, uint32_t> ids;
+		std::unordered_map<utf8_string, std::vector<uint32_t>> variants;
+	};
+}
@@ -0,0 +1,257 @@
+#include "interned_dictionary.h"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+	using dictionary_creator::string_id;
+
+	// first position of [first, last) not less than id, probing 1, 2, 4... positions ahead before the binary search,
+	// so that finding it costs the logarithm of the distance rather than that of the whole range
+	const string_id *gallop(const string_id *first, const string_id *last, string_id id) noexcept
+	{
+		const size_t size = static_cast<size_t>(last - first);
+
+		size_t bound = 1;
+		while (bound < size && first[bound] < id)
+		{
+			bound *= 2;
+		}
+
+		return std::lower_bound(first + bound / 2, first + std::min(bound + 1, size), id);
+	}
+
+	// walks two sorted id arrays together: only_left and only_right get the index ranges of ids the other side lacks,
+	// both gets the indexes of an id they share
+	template <typename OnlyLeft, typename OnlyRight, typename Both>
+	void walk(const std::vector<string_id> &left, const std::vector<string_id> &right, OnlyLeft &&only_left, OnlyRight &&only_right, Both &&both)
+	{
+		const string_id *a = left.data(), *a_end = a + left.size();
+		const string_id *b = right.data(), *b_end = b + right.size();
+
+		while (a != a_end && b != b_end)
+		{
+			if (*a < *b)
+			{
+				const auto next = gallop(a, a_end, *b);
+				only_left(a - left.data(), next - left.data());
+				a = next;
+			}
+			else if (*b < *a)
+			{
+				const auto next = gallop(b, b_end, *a);
+				only_right(b - right.data(), next - right.data());
+				b = next;
+			}
+			else
+			{
+				both(a++ - left.data(), b++ - right.data());
+			}
+		}
+
+		if (a != a_end)
+		{
+			only_left(a - left.data(), left.size());
+		}
+		if (b != b_end)
+		{
+			only_right(b - right.data(), right.size());
+		}
+	}
+}
+
+dictionary_creator::InternedDictionary::InternedDictionary(dictionary_creator::Language language, dictionary_creator::StringPool &symbols)
+	: language{ language }, symbols{ &symbols }
+{
+}
+
+dictionary_creator::InternedDictionary::InternedDictionary(dictionary_creator::Language language,
+		const std::vector<std::shared_ptr<dictionary_creator::Entry>> &entries, dictionary_creator::StringPool &symbols)
+	: language{ language }, symbols{ &symbols }
+{
+	std::vector<std::pair<dictionary_creator::string_id, size_t>> words;
+	words.reserve(entries.size());
+
+	for (const auto &entry: entries)
+	{
+		words.emplace_back(symbols.intern(static_cast<const char *>(*entry)), entry->get_counter());
+	}
+
+	std::sort(words.begin(), words.end(),
+			[] (const auto &a, const auto &b) { return a.first < b.first; });
+
+	ids.reserve(words.size());
+	counters.reserve(words.size());
+
+	for (const auto &[id, counter]: words)
+	{
+		if (!ids.empty() && ids.back() == id)
+		{
+			counters.back() += counter;
+			continue;
+		}
+
+		ids.push_back(id);
+		counters.push_back(counter);
+	}
+}
+
+dictionary_creator::InternedDictionary &dictionary_creator::InternedDictionary::merge(const dictionary_creator::InternedDictionary &other)
+{
+	check_compatible(other, "merge");
+
+	std::vector<dictionary_creator::string_id> merged_ids;
+	std::vector<size_t> merged_counters;
+	merged_ids.reserve(ids.size() + other.ids.size());
+	merged_counters.reserve(ids.size() + other.ids.size());
+
+	walk(ids, other.ids,
+		[&] (size_t first, size_t last)
+		{
+			merged_ids.insert(merged_ids.end(), ids.begin() + first, ids.begin() + last);
+			merged_counters.insert(merged_counters.end(), counters.begin() + first, counters.begin() + last);
+		},
+		[&] (size_t first, size_t last)
+		{
+			merged_ids.insert(merged_ids.end(), other.ids.begin() + first, other.ids.begin() + last);
+			merged_counters.insert(merged_counters.end(), other.counters.begin() + first, other.counters.begin() + last);
+		},
+		[&] (size_t own, size_t others)
+		{
+			merged_ids.push_back(ids[own]);
+			merged_counters.push_back(counters[own] + other.counters[others]);
+		});
+
+	ids = std::move(merged_ids);
+	counters = std::move(merged_counters);
+
+	return *this;
+}
+
+dictionary_creator::InternedDictionary &dictionary_creator::InternedDictionary::subtract(const dictionary_creator::InternedDictionary &other)
+{
+	check_compatible(other, "subtract");
+
+	// kept ranges only ever move towards the front, so the arrays are compacted in place
+	size_t kept = 0;
+
+	walk(ids, other.ids,
+		[&] (size_t first, size_t last)
+		{
+			if (kept != first)
+			{
+				std::copy(ids.begin() + first, ids.begin() + last, ids.begin() + kept);
+				std::copy(counters.begin() + first, counters.begin() + last, counters.begin() + kept);
+			}
+			kept += last - first;
+		},
+		[] (size_t, size_t) {},
+		[] (size_t, size_t) {});
+
+	ids.resize(kept);
+	counters.resize(kept);
+
+	return *this;
+}
+
+dictionary_creator::InternedDictionary dictionary_creator::InternedDictionary::intersection_with(const dictionary_creator::InternedDictionary &other) const
+{
+	check_compatible(other, "intersect");
+
+	dictionary_creator::InternedDictionary result(language, *symbols);
+	result.ids.reserve(std::min(ids.size(), other.ids.size()));
+	result.counters.reserve(std::min(ids.size(), other.ids.size()));
+
+	walk(ids, other.ids,
+		[] (size_t, size_t) {},
+		[] (size_t, size_t) {},
+		[&] (size_t own, size_t)
+		{
+			result.ids.push_back(ids[own]);
+			result.counters.push_back(counters[own]);
+		});
+
+	return result;
+}
+
+bool dictionary_creator::InternedDictionary::contains_word(std::string_view word) const
+{
+	return find(word) != npos;
+}
+
+size_t dictionary_creator::InternedDictionary::get_counter(std::string_view word) const
+{
+	const auto position = find(word);
+
+	return position != npos ? counters[position] : 0;
+}
+
+std::vector<std::pair<std::string_view, size_t>> dictionary_creator::InternedDictionary::counted_words() const
+{
+	std::vector<std::pair<std::string_view, size_t>> result;
+	result.reserve(ids.size());
+
+	for (size_t i = 0; i != ids.size(); ++i)
+	{
+		result.emplace_back(symbols->view(ids[i]), counters[i]);
+	}
+
+	return result;
+}
+
+const std::vector<dictionary_creator::string_id> &dictionary_creator::InternedDictionary::get_ids() const noexcept
+{
+	return ids;
+}
+
+const std::vector<size_t> &dictionary_creator::InternedDictionary::get_counters() const noexcept
+{
+	return counters;
+}
+
+dictionary_creator::StringPool &dictionary_creator::InternedDictionary::get_symbols() const noexcept
+{
+	return *symbols;
+}
+
+size_t dictionary_creator::InternedDictionary::total_words() const noexcept
+{
+	return ids.size();
+}
+
+dictionary_creator::Language dictionary_creator::InternedDictionary::get_language() const noexcept
+{
+	return language;
+}
+
+size_t dictionary_creator::InternedDictionary::memory_usage() const noexcept
+{
+	return ids.capacity() * sizeof(dictionary_creator::string_id) + counters.capacity() * sizeof(size_t);
+}
+
+size_t dictionary_creator::InternedDictionary::find(std::string_view word) const
+{
+	const auto id = symbols->find(word);
+	if (!id)
+	{
+		return npos;
+	}
+
+	const auto position = std::lower_bound(ids.begin(), ids.end(), *id);
+
+	return (position != ids.end() && *position == *id) ? static_cast<size_t>(position - ids.begin()) : npos;
+}
+
+void dictionary_creator::InternedDictionary::check_compatible(const dictionary_creator::InternedDictionary &other, const char *operation) const
+{
+	if (language != other.language)
+	{
+		throw dictionary_creator::dictionary_runtime_error(std::string("an attempt to ") + operation + " language mismatching dictionaries");
+	}
+
+	if (symbols != other.symbols)
+	{
+		throw dictionary_creator::dictionary_runtime_error(std::string("an attempt to ") + operation + " dictionaries interned into different symbol tables");
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "dictionary_types.h"
+#include "dictionary_entry.h"
+#include "dictionary_language.h"
+#include "compact_definitions.h"
+
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Words of a Dictionary as sorted ids of a StringPool, for set algebra between many dictionaries, produced by Dictionary::intern().
+//
+// 	-- every word is interned once in the symbol table (StringPool::shared_words() unless told otherwise),
+// 	   all dictionaries interned into the same table compare their words as 32-bit integers
+// 	-- ids are kept sorted in one array, counters in a parallel one; merge, subtract and intersection_with walk both arrays at once,
+// 	   galloping over the runs one side doesn't share with the other, so a small dictionary against a large one costs
+// 	   about the logarithm of the gap rather than the gap itself
+// 	-- only words and counters are carried, definitions and proper nouns stay with the origin;
+// 	   strings are looked at only on the way in and out (contains_word(), get_counter(), counted_words())
+
+namespace dictionary_creator
+{
+	class InternedDictionary
+	{
+	public:
+		explicit InternedDictionary(Language language, StringPool &symbols = StringPool::shared_words());
+		InternedDictionary(Language language, const std::vector<std::shared_ptr<Entry>> &entries,
+			StringPool &symbols = StringPool::shared_words());
+
+		// counters of words both of them hold are summed up
+		InternedDictionary &merge(const InternedDictionary &other);
+		InternedDictionary &subtract(const InternedDictionary &other);
+		// words both of them hold, with the counters of this one
+		InternedDictionary intersection_with(const InternedDictionary &other) const;
+
+		bool contains_word(std::string_view word) const;
+		size_t get_counter(std::string_view word) const;
+		// words in the order of their ids, not in that of a Dictionary
+		std::vector<std::pair<std::string_view, size_t>> counted_words() const;
+
+		const std::vector<string_id> &get_ids() const noexcept;
+		const std::vector<size_t> &get_counters() const noexcept;
+		StringPool &get_symbols() const noexcept;
+
+		size_t total_words() const noexcept;
+		Language get_language() const noexcept;
+		// bytes of the two arrays, the words themselves are reported by StringPool::memory_usage()
+		size_t memory_usage() const noexcept;
+
+	private:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		Language language;
+		StringPool *symbols;
+		std::vector<string_id> ids;
+		std::vector<size_t> counters;
+
+		size_t find(std::string_view word) const;
+		void check_compatible(const InternedDictionary &other, const char *operation) const;
+	};
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "dictionary_types.h"
+#include "dictionary_language.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifndef BOOST_UNAVAILABLE
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/collections_save_imp.hpp>
+#include <boost/serialization/detail/stack_constructor.hpp>
+#endif
+
+// Letter to bucket association of a Dictionary, standing in for std::map<letter_type, Bucket>.
+//
+// 	-- letters are kept in alphabetical (collation) order, so iteration order is the one of the map it replaces
+// 	-- the code point of a letter indexes a fixed table of positions, so selecting a bucket is O(1) and allocates nothing;
+// 	   the table covers Latin-1, Œ, Ÿ, ẞ and basic Cyrillic, any other letter is found by binary search
+// 	-- buckets never move, references to them stay valid when new letters are added
+// 	-- buckets of new letters are copies of the blank one given upon construction, copies and assignments take it over
+// 	-- archives are laid out as those of std::map, so the dictionaries saved before remain loadable;
+// 	   buckets loaded keep the memory resource of the blank one
+
+namespace dictionary_creator
+{
+	template <typename Bucket>
+	class LetterMap
+	{
+	public:
+		using key_type = letter_type;
+		using mapped_type = Bucket;
+		using value_type = std::pair<const letter_type, Bucket>;
+		using iterator = typename std::list<value_type>::iterator;
+		using const_iterator = typename std::list<value_type>::const_iterator;
+
+		explicit LetterMap(Bucket blank = Bucket{})
+			: blank{ std::move(blank) }
+		{
+			slots.fill(0);
+		}
+
+		LetterMap(const LetterMap &other)
+			: nodes{ other.nodes }, blank{ other.blank }
+		{
+			reindex();
+		}
+
+		LetterMap(LetterMap &&other) noexcept
+			: nodes{ std::move(other.nodes) }, ordered{ std::move(other.ordered) }, slots{ other.slots }, blank{ other.blank }
+		{
+			other.clear();
+		}
+
+		LetterMap &operator=(const LetterMap &other)
+		{
+			if (this != &other)
+			{
+				*this = LetterMap(other);
+			}
+			return *this;
+		}
+
+		LetterMap &operator=(LetterMap &&other) noexcept
+		{
+			if (this != &other)
+			{
+				nodes = std::move(other.nodes);
+				ordered = std::move(other.ordered);
+				slots = other.slots;
+				blank = other.blank;
+				other.clear();
+			}
+			return *this;
+		}
+
+		Bucket &operator[](const letter_type &letter)
+		{
+			if (auto index = locate(letter); index != absent)
+			{
+				return ordered[index]->second;
+			}
+
+			const auto index = static_cast<size_t>(lower_bound(letter) - ordered.begin());
+			const auto following = (index == ordered.size()) ? nodes.end() : ordered[index];
+
+			auto created = nodes.emplace(following, std::piecewise_construct, std::forward_as_tuple(letter), std::forward_as_tuple(blank));
+			ordered.insert(ordered.begin() + static_cast<std::ptrdiff_t>(index), created);
+			reindex_slots();
+
+			return created->second;
+		}
+
+		Bucket &at(const letter_type &letter)
+		{
+			if (auto index = locate(letter); index != absent)
+			{
+				return ordered[index]->second;
+			}
+			throw std::out_of_range("no bucket for the letter");
+		}
+
+		const Bucket &at(const letter_type &letter) const
+		{
+			if (auto index = locate(letter); index != absent)
+			{
+				return ordered[index]->second;
+			}
+			throw std::out_of_range("no bucket for the letter");
+		}
+
+		iterator find(const letter_type &letter)
+		{
+			auto index = locate(letter);
+			return index != absent ? ordered[index] : nodes.end();
+		}
+
+		const_iterator find(const letter_type &letter) const
+		{
+			auto index = locate(letter);
+			return index != absent ? const_iterator{ ordered[index] } : nodes.end();
+		}
+
+		iterator begin() noexcept { return nodes.begin(); }
+		iterator end() noexcept { return nodes.end(); }
+		const_iterator begin() const noexcept { return nodes.begin(); }
+		const_iterator end() const noexcept { return nodes.end(); }
+
+		size_t size() const noexcept { return nodes.size(); }
+		bool empty() const noexcept { return nodes.empty(); }
+
+		void clear() noexcept
+		{
+			nodes.clear();
+			ordered.clear();
+			slots.fill(0);
+		}
+
+	private:
+		static constexpr size_t absent = static_cast<size_t>(-1);
+
+		std::list<value_type> nodes;
+		std::vector<iterator> ordered;
+		std::array<uint8_t, 0x163> slots;
+		Bucket blank;
+
+		// 0x000-0x0FF single bytes and Latin-1, 0x100-0x15F Cyrillic U+0400-U+045F, 0x160-0x162 Œ, Ÿ and ẞ
+		static size_t slot_of(const letter_type &letter) noexcept
+		{
+			const auto lead = static_cast<unsigned char>(letter.empty() ? 0 : letter[0]);
+			const size_t expected = lead < 0x80 ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : 0;
+
+			if (letter.size() == 1)
+			{
+				return lead;
+			}
+			else if (letter.size() != expected)
+			{
+				return absent;
+			}
+
+			char32_t code = lead & (0x7F >> expected);
+			for (size_t i = 1; i != expected; ++i)
+			{
+				code = (code << 6) | (static_cast<unsigned char>(letter[i]) & 0x3F);
+			}
+
+			if (code < 0x100)
+			{
+				return code;
+			}
+			else if (0x400 <= code && code < 0x460)
+			{
+				return 0x100 + (code - 0x400);
+			}
+			else if (code == 0x152)
+			{
+				return 0x160;
+			}
+			else if (code == 0x178)
+			{
+				return 0x161;
+			}
+			else if (code == 0x1E9E)
+			{
+				return 0x162;
+			}
+
+			return absent;
+		}
+
+		typename std::vector<iterator>::const_iterator lower_bound(const letter_type &letter) const
+		{
+			return std::lower_bound(ordered.begin(), ordered.end(), letter,
+				[] (const iterator &node, const letter_type &letter) { return collation_less(node->first, letter); });
+		}
+
+		size_t locate(const letter_type &letter) const
+		{
+			if (auto slot = slot_of(letter); slot != absent && slots[slot] != 0 && ordered[slots[slot] - 1]->first == letter)
+			{
+				return slots[slot] - 1;
+			}
+
+			if (auto position = lower_bound(letter); position != ordered.end() && (*position)->first == letter)
+			{
+				return static_cast<size_t>(position - ordered.begin());
+			}
+
+			return absent;
+		}
+
+		void reindex()
+		{
+			ordered.clear();
+			for (auto node = nodes.begin(); node != nodes.end(); ++node)
+			{
+				ordered.push_back(node);
+			}
+			reindex_slots();
+		}
+
+		void reindex_slots() noexcept
+		{
+			slots.fill(0);
+
+			for (size_t i = 0; i != ordered.size() && i < UINT8_MAX; ++i)
+			{
+				if (auto slot = slot_of(ordered[i]->first); slot != absent && slots[slot] == 0)
+				{
+					slots[slot] = static_cast<uint8_t>(i + 1);
+				}
+			}
+		}
+
+#ifndef BOOST_UNAVAILABLE
+		friend class boost::serialization::access;
+#endif
+
+		template <typename A>
+		void serialize(A &arch, [[ maybe_unused ]] const unsigned int version)
+		{
+#ifndef BOOST_UNAVAILABLE
+			if constexpr (A::is_saving::value)
+			{
+				boost::serialization::stl::save_collection<A, LetterMap>(arch, *this);
+			}
+			else
+			{
+				clear();
+
+				const boost::serialization::library_version_type library_version(arch.get_library_version());
+				boost::serialization::item_version_type item_version(0);
+				boost::serialization::collection_size_type count;
+
+				arch >> BOOST_SERIALIZATION_NVP(count);
+				if (boost::serialization::library_version_type(3) < library_version)
+				{
+					arch >> BOOST_SERIALIZATION_NVP(item_version);
+				}
+
+				while (count-- > 0)
+				{
+					boost::serialization::detail::stack_construct<A, value_type> item(arch, item_version);
+					arch >> boost::serialization::make_nvp("item", item.reference());
+
+					// merged rather than assigned, so that the bucket keeps the memory resource of the blank one;
+					// contents loaded by another resource are copied into it
+					auto &bucket = (*this)[item.reference().first];
+					bucket.merge(std::move(item.reference().second));
+					arch.reset_object_address(&bucket, &item.reference().second);
+				}
+			}
+#endif
+		}
+	};
+}
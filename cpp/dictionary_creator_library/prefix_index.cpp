@@ -0,0 +1,205 @@
+#include "prefix_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+dictionary_creator::PrefixIndex::PrefixIndex()
+	: nodes(1, Node{ no_node, no_node, 0, 0, nullptr }), words{ 0 }
+{}
+
+void dictionary_creator::PrefixIndex::insert(const std::shared_ptr<dictionary_creator::Entry> &entry)
+{
+	const std::string_view word = static_cast<const char *>(*entry);
+
+	uint32_t current = root;
+
+	for (auto character: word)
+	{
+		const auto label = static_cast<unsigned char>(character);
+
+		uint32_t previous = no_node;
+		uint32_t child = nodes[current].first_child;
+
+		while (child != no_node && nodes[child].label < label)
+		{
+			previous = child;
+			child = nodes[child].next_sibling;
+		}
+
+		if (child == no_node || nodes[child].label != label)
+		{
+			if (nodes.size() == std::numeric_limits<uint32_t>::max())
+			{
+				throw dictionary_creator::dictionary_runtime_error("prefix index is out of node indices");
+			}
+
+			nodes.push_back(Node{ no_node, child, label, 0, nullptr });
+			auto created = static_cast<uint32_t>(nodes.size() - 1);
+
+			if (previous == no_node)
+			{
+				nodes[current].first_child = created;
+			}
+			else
+			{
+				nodes[previous].next_sibling = created;
+			}
+
+			child = created;
+		}
+
+		current = child;
+	}
+
+	if (current == root)
+	{
+		return;
+	}
+
+	words += (nodes[current].entry == nullptr);
+	nodes[current].entry = entry;
+
+	refresh_path(word);
+}
+
+void dictionary_creator::PrefixIndex::erase(std::string_view word)
+{
+	if (auto node = find_node(word); node != no_node && nodes[node].entry != nullptr)
+	{
+		nodes[node].entry.reset();
+		--words;
+
+		refresh_path(word);
+	}
+}
+
+void dictionary_creator::PrefixIndex::clear()
+{
+	nodes.assign(1, Node{ no_node, no_node, 0, 0, nullptr });
+	words = 0;
+}
+
+uint32_t dictionary_creator::PrefixIndex::find_node(std::string_view word) const noexcept
+{
+	uint32_t current = root;
+
+	for (auto character: word)
+	{
+		const auto label = static_cast<unsigned char>(character);
+
+		uint32_t child = nodes[current].first_child;
+		while (child != no_node && nodes[child].label < label)
+		{
+			child = nodes[child].next_sibling;
+		}
+
+		if (child == no_node || nodes[child].label != label)
+		{
+			return no_node;
+		}
+
+		current = child;
+	}
+
+	return current;
+}
+
+void dictionary_creator::PrefixIndex::refresh_path(std::string_view word)
+{
+	std::vector<uint32_t> path{ root };
+	path.reserve(word.size() + 1);
+
+	for (auto character: word)
+	{
+		const auto label = static_cast<unsigned char>(character);
+
+		uint32_t child = nodes[path.back()].first_child;
+		while (nodes[child].label != label)
+		{
+			child = nodes[child].next_sibling;
+		}
+
+		path.push_back(child);
+	}
+
+	for (auto node = path.rbegin(); node != path.rend(); ++node)
+	{
+		auto &current = nodes[*node];
+
+		current.best = current.entry ? current.entry->get_counter() : 0;
+
+		for (auto child = current.first_child; child != no_node; child = nodes[child].next_sibling)
+		{
+			current.best = std::max(current.best, nodes[child].best);
+		}
+	}
+}
+
+std::vector<std::shared_ptr<dictionary_creator::Entry>> dictionary_creator::PrefixIndex::complete(std::string_view prefix, size_t number) const
+{
+	std::vector<std::shared_ptr<dictionary_creator::Entry>> result;
+
+	const auto start = prefix.empty() ? root : find_node(prefix);
+	if (number == 0 || (start == no_node && !prefix.empty()) || nodes[start].best == 0)
+	{
+		return result;
+	}
+
+	struct Candidate
+	{
+		size_t key;
+		uint32_t node;
+		bool terminal;
+	};
+
+	auto lesser = [] (const Candidate &a, const Candidate &b)
+	{
+		if (a.key != b.key)
+		{
+			return a.key < b.key;
+		}
+		else if (a.terminal != b.terminal)
+		{
+			return b.terminal;
+		}
+		return a.node > b.node;
+	};
+
+	std::priority_queue<Candidate, std::vector<Candidate>, decltype(lesser)> candidates(lesser);
+	candidates.push(Candidate{ nodes[start].best, start, false });
+
+	while (!candidates.empty() && result.size() != number)
+	{
+		auto best = candidates.top();
+		candidates.pop();
+
+		const auto &node = nodes[best.node];
+
+		if (best.terminal)
+		{
+			result.push_back(node.entry);
+			continue;
+		}
+
+		if (node.entry)
+		{
+			candidates.push(Candidate{ node.entry->get_counter(), best.node, true });
+		}
+
+		for (auto child = node.first_child; child != no_node; child = nodes[child].next_sibling)
+		{
+			if (nodes[child].best != 0)
+			{
+				candidates.push(Candidate{ nodes[child].best, child, false });
+			}
+		}
+	}
+
+	return result;
+}
+
+size_t dictionary_creator::PrefixIndex::total_words() const noexcept
+{
+	return words;
+}
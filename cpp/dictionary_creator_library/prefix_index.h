@@ -0,0 +1,52 @@
+#pragma once
+
+#include "dictionary_types.h"
+#include "dictionary_entry.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Byte trie over the entries of one Dictionary, answering "most frequent words starting with prefix".
+//
+// 	-- every node caches the highest counter found in its subtree
+// 	-- completion walks the prefix and then expands the subtrees best-first, so the work depends
+// 	   on the prefix length and the number of completions requested rather than on the dictionary size
+// 	-- counters are observed when an entry is inserted or refreshed by the owning Dictionary;
+// 	   increments done directly through an entry pointer are seen upon the next refresh of that word
+
+namespace dictionary_creator
+{
+	class PrefixIndex
+	{
+	public:
+		PrefixIndex();
+
+		void insert(const std::shared_ptr<Entry> &entry);
+		void erase(std::string_view word);
+		void clear();
+
+		std::vector<std::shared_ptr<Entry>> complete(std::string_view prefix, size_t number) const;
+		size_t total_words() const noexcept;
+
+	private:
+		struct Node
+		{
+			uint32_t first_child;
+			uint32_t next_sibling;
+			unsigned char label;
+			size_t best;
+			std::shared_ptr<Entry> entry;
+		};
+
+		static constexpr uint32_t root = 0;
+		static constexpr uint32_t no_node = 0;
+
+		uint32_t find_node(std::string_view word) const noexcept;
+		void refresh_path(std::string_view word);
+
+		std::vector<Node> nodes;
+		size_t words;
+	};
+}
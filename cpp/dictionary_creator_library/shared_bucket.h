@@ -0,0 +1,217 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#ifndef BOOST_UNAVAILABLE
+#include <boost/serialization/serialization.hpp>
+#endif
+
+// Copy-on-write holder of a letter bucket (a set of entries) of a Dictionary.
+//
+// 	-- copies share the contents, so copying a dictionary no longer copies its words
+// 	-- the first modification of a shared bucket clones it, the other holders keep seeing the old contents
+// 	-- only const iteration is offered, so walking a bucket never clones it;
+// 	   iterators taken before a modification are translated to the clone by erase() and extract()
+// 	-- an empty bucket holds no contents at all, creating one allocates nothing
+// 	-- contents are allocated by the memory resource of the bucket, and so are the nodes of allocator-aware containers;
+// 	   contents of a bucket using another resource are never taken over, their elements are copied
+// 	-- archives are laid out as those of the container itself
+
+namespace dictionary_creator
+{
+	template <typename Container>
+	class SharedBucket
+	{
+	public:
+		using container_type = Container;
+		using key_type = typename Container::key_type;
+		using value_type = typename Container::value_type;
+		using size_type = typename Container::size_type;
+		using iterator = typename Container::const_iterator;
+		using const_iterator = typename Container::const_iterator;
+		using node_type = typename Container::node_type;
+		using insert_return_type = typename Container::insert_return_type;
+
+		explicit SharedBucket(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+			: resource{ resource }
+		{}
+
+		std::pmr::memory_resource *get_resource() const noexcept { return resource; }
+
+		const_iterator begin() const noexcept { return view().begin(); }
+		const_iterator end() const noexcept { return view().end(); }
+
+		size_type size() const noexcept { return contents ? contents->size() : 0; }
+		bool empty() const noexcept { return size() == 0; }
+
+		// true if other copies still see these very contents
+		bool is_shared() const noexcept { return contents.use_count() > 1; }
+		bool shares_contents_with(const SharedBucket &other) const noexcept { return contents && contents == other.contents; }
+
+		template <typename Key>
+		const_iterator find(const Key &key) const
+		{
+			return view().find(key);
+		}
+
+		template <typename Key>
+		size_type count(const Key &key) const
+		{
+			return view().count(key);
+		}
+
+		template <typename Key>
+		const_iterator lower_bound(const Key &key) const
+		{
+			return view().lower_bound(key);
+		}
+
+		std::pair<iterator, bool> insert(const value_type &value)
+		{
+			return write().insert(value);
+		}
+
+		std::pair<iterator, bool> insert(value_type &&value)
+		{
+			return write().insert(std::move(value));
+		}
+
+		// nodes extracted from this very bucket only, nodes of other resources can't be taken over
+		insert_return_type insert(node_type &&node)
+		{
+			return write().insert(std::move(node));
+		}
+
+		// the hint only helps contents owned alone, shared ones are cloned and the hint would point into the old contents
+		iterator insert(const_iterator hint, const value_type &value)
+		{
+			if (!contents || is_shared())
+			{
+				return write().insert(value).first;
+			}
+			return contents->insert(hint, value);
+		}
+
+		iterator insert(const_iterator hint, node_type &&node)
+		{
+			if (!contents || is_shared())
+			{
+				return write().insert(std::move(node)).position;
+			}
+			return contents->insert(hint, std::move(node));
+		}
+
+		size_type erase(const key_type &key)
+		{
+			return (contents && contents->count(key) != 0) ? write().erase(key) : 0;
+		}
+
+		iterator erase(const_iterator position)
+		{
+			position = relocate(position);
+			return contents->erase(position);
+		}
+
+		node_type extract(const_iterator position)
+		{
+			position = relocate(position);
+			return contents->extract(position);
+		}
+
+		// elements already present stay in other, as with Container::merge()
+		void merge(SharedBucket &&other)
+		{
+			if (other.contents == contents || other.empty())
+			{
+				return;
+			}
+			else if (empty() && *other.resource == *resource)
+			{
+				contents = std::move(other.contents);
+			}
+			else if (other.is_shared() || *other.resource != *resource)
+			{
+				write().insert(other.begin(), other.end());
+			}
+			else
+			{
+				write().merge(*other.contents);
+			}
+		}
+
+		void clear() noexcept
+		{
+			contents.reset();
+		}
+
+	private:
+		std::shared_ptr<Container> contents;
+		std::pmr::memory_resource *resource;
+
+		static const Container &nothing() noexcept
+		{
+			static const Container empty_container;
+			return empty_container;
+		}
+
+		const Container &view() const noexcept
+		{
+			return contents ? *contents : nothing();
+		}
+
+		// a polymorphic allocator hands itself over to the containers it constructs
+		template <typename ... Args>
+		std::shared_ptr<Container> make_contents(Args &&... args) const
+		{
+			return std::allocate_shared<Container>(std::pmr::polymorphic_allocator<Container>(resource), std::forward<Args>(args)...);
+		}
+
+		Container &write()
+		{
+			if (!contents)
+			{
+				contents = make_contents();
+			}
+			else if (is_shared())
+			{
+				contents = make_contents(*contents);
+			}
+
+			return *contents;
+		}
+
+		const_iterator relocate(const_iterator position)
+		{
+			if (is_shared())
+			{
+				auto key = *position;
+				write();
+				return contents->find(key);
+			}
+
+			return position;
+		}
+
+#ifndef BOOST_UNAVAILABLE
+		friend class boost::serialization::access;
+#endif
+
+		template <typename A>
+		void serialize(A &arch, [[ maybe_unused ]] const unsigned int version)
+		{
+#ifndef BOOST_UNAVAILABLE
+			if constexpr (A::is_loading::value)
+			{
+				contents = make_contents();
+				boost::serialization::serialize_adl(arch, *contents, version);
+			}
+			else
+			{
+				boost::serialization::serialize_adl(arch, const_cast<Container &>(view()), version);
+			}
+#endif
+		}
+	};
+}
@@ -0,0 +1,127 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <numeric>
+
+dictionary_creator::ThreadPool::ThreadPool(size_t threads)
+{
+	// the thread calling run() is one of them
+	for (size_t i = 1; i < threads; ++i)
+	{
+		workers.emplace_back(&dictionary_creator::ThreadPool::serve, this);
+	}
+}
+
+dictionary_creator::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (auto &worker: workers)
+	{
+		worker.join();
+	}
+}
+
+void dictionary_creator::ThreadPool::run(const std::vector<size_t> &weights, const std::function<void(size_t)> &job)
+{
+	if (weights.empty())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> exclusive(running);
+
+	auto batch = std::make_shared<dictionary_creator::ThreadPool::Batch>();
+	batch->job = &job;
+	batch->order.resize(weights.size());
+	std::iota(batch->order.begin(), batch->order.end(), size_t{ 0 });
+	std::stable_sort(batch->order.begin(), batch->order.end(), [&weights] (size_t a, size_t b) { return weights[a] > weights[b]; });
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		current = batch;
+		++generation;
+	}
+	wake.notify_all();
+
+	work(*batch);
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [&batch] { return batch->done == batch->order.size(); });
+		current.reset();
+	}
+
+	if (batch->error)
+	{
+		std::rethrow_exception(batch->error);
+	}
+}
+
+size_t dictionary_creator::ThreadPool::size() const noexcept
+{
+	return workers.size() + 1;
+}
+
+size_t dictionary_creator::ThreadPool::default_threads() noexcept
+{
+	return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void dictionary_creator::ThreadPool::serve()
+{
+	size_t seen = 0;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		wake.wait(lock, [this, &seen] { return stopping || generation != seen; });
+		if (stopping)
+		{
+			return;
+		}
+
+		seen = generation;
+
+		// a worker waking up late may find the batch over already
+		if (auto batch = current; batch)
+		{
+			lock.unlock();
+			work(*batch);
+			lock.lock();
+		}
+	}
+}
+
+void dictionary_creator::ThreadPool::work(dictionary_creator::ThreadPool::Batch &batch)
+{
+	for (size_t i = batch.next++; i < batch.order.size(); i = batch.next++)
+	{
+		std::exception_ptr error;
+
+		try
+		{
+			(*batch.job)(batch.order[i]);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (error && !batch.error)
+		{
+			batch.error = error;
+		}
+
+		if (++batch.done == batch.order.size())
+		{
+			finished.notify_all();
+		}
+	}
+}
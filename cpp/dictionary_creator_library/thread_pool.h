@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running batches of independent jobs, such as the letter buckets of a Dictionary.
+//
+// 	-- run() hands the jobs out heaviest first and returns once all of them are done; the calling thread works on them too,
+// 	   so a pool of one thread runs everything on the caller
+// 	-- every idle thread takes the next job as soon as it finishes one, so a few large jobs don't leave the other threads waiting
+// 	   behind a static split
+// 	-- the first exception a job throws is rethrown by run() after the rest of the batch is done
+// 	-- batches of different callers don't interleave, they run one after another
+
+namespace dictionary_creator
+{
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(size_t threads = default_threads());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+		// job(i) is called once for every i below weights.size(), jobs of greater weights start first
+		void run(const std::vector<size_t> &weights, const std::function<void(size_t)> &job);
+
+		size_t size() const noexcept;
+
+		static size_t default_threads() noexcept;
+
+	private:
+		struct Batch
+		{
+			std::vector<size_t> order;
+			const std::function<void(size_t)> *job = nullptr;
+			std::atomic<size_t> next{ 0 };
+			size_t done = 0;
+			std::exception_ptr error;
+		};
+
+		std::vector<std::thread> workers;
+
+		std::mutex running;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable finished;
+		std::shared_ptr<Batch> current;
+		size_t generation = 0;
+		bool stopping = false;
+
+		void serve();
+		void work(Batch &batch);
+	};
+}
@@ -0,0 +1,100 @@
+#include "word_filter.h"
+#include "dictionary_hash.h"
+#include "dictionary_types.h"
+
+#include <algorithm>
+#include <cmath>
+
+dictionary_creator::WordFilter::WordFilter(double false_positive_rate, size_t expected_words)
+	: false_positive_rate{ false_positive_rate }, capacity{ std::max(expected_words, minimal_capacity) }
+{
+	if (!(0.0 < false_positive_rate && false_positive_rate < 1.0))
+	{
+		throw dictionary_creator::dictionary_runtime_error("false positive rate of a word filter has to be between 0 and 1");
+	}
+
+	// the optimal filter spends -log2(p) / ln(2) bits on a word and probes -log2(p) of them
+	const double bits_per_word = -std::log2(false_positive_rate) / std::log(2.0);
+	const auto wanted_bits = static_cast<uint64_t>(std::ceil(bits_per_word * static_cast<double>(capacity)));
+
+	uint64_t total_bits = 64;
+	while (total_bits < wanted_bits)
+	{
+		total_bits <<= 1;
+	}
+
+	probes = std::max<size_t>(1, static_cast<size_t>(std::lround(-std::log2(false_positive_rate))));
+	mask = total_bits - 1;
+	bits.assign(total_bits / 64, 0);
+}
+
+bool dictionary_creator::WordFilter::insert(std::string_view word) noexcept
+{
+	uint64_t position = dictionary_creator::hash_bytes(word);
+	const uint64_t step = dictionary_creator::mix_hash(position) | 1;
+
+	bool changed = false;
+	for (size_t i = 0; i != probes; ++i, position += step)
+	{
+		auto &cell = bits[(position & mask) >> 6];
+		const uint64_t bit = uint64_t{ 1 } << (position & 63);
+
+		changed |= (cell & bit) == 0;
+		cell |= bit;
+	}
+
+	if (changed)
+	{
+		++inserted;
+	}
+
+	return changed;
+}
+
+bool dictionary_creator::WordFilter::may_contain(std::string_view word) const noexcept
+{
+	uint64_t position = dictionary_creator::hash_bytes(word);
+	const uint64_t step = dictionary_creator::mix_hash(position) | 1;
+
+	for (size_t i = 0; i != probes; ++i, position += step)
+	{
+		if ((bits[(position & mask) >> 6] & (uint64_t{ 1 } << (position & 63))) == 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void dictionary_creator::WordFilter::forget() noexcept
+{
+	++forgotten;
+}
+
+void dictionary_creator::WordFilter::clear() noexcept
+{
+	std::fill(bits.begin(), bits.end(), 0);
+	inserted = 0;
+	forgotten = 0;
+}
+
+bool dictionary_creator::WordFilter::needs_rebuild() const noexcept
+{
+	return inserted > capacity || forgotten * 2 > std::max(inserted, minimal_capacity);
+}
+
+size_t dictionary_creator::WordFilter::get_capacity() const noexcept
+{
+	return capacity;
+}
+
+double dictionary_creator::WordFilter::get_false_positive_rate() const noexcept
+{
+	return false_positive_rate;
+}
+
+size_t dictionary_creator::WordFilter::memory_usage() const noexcept
+{
+	return bits.capacity() * sizeof(uint64_t);
+}
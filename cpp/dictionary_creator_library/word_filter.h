@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Bloom filter over the words of one Dictionary, rejecting most of the words it doesn't hold before the real lookup.
+//
+// 	-- may_contain() never answers false for a word inserted, it answers true for an absent one with about the configured probability
+// 	-- sized for a number of words, the owning Dictionary rebuilds it twice as large once more words than that are inserted
+// 	-- words can't be taken out, forget() only counts them; once they make up half of the words inserted
+// 	   the filter asks to be rebuilt, so that their bits stop raising the false positive rate
+// 	-- hashes are those of dictionary_hash.h, the probes are derived from a single one by double hashing
+
+namespace dictionary_creator
+{
+	class WordFilter
+	{
+	public:
+		static constexpr double default_false_positive_rate = 0.01;
+
+		explicit WordFilter(double false_positive_rate = default_false_positive_rate, size_t expected_words = 0);
+
+		// false if every bit of the word was set already, that is the word is most likely a known one
+		bool insert(std::string_view word) noexcept;
+		bool may_contain(std::string_view word) const noexcept;
+		void forget() noexcept;
+		void clear() noexcept;
+
+		bool needs_rebuild() const noexcept;
+
+		size_t get_capacity() const noexcept;
+		double get_false_positive_rate() const noexcept;
+		size_t memory_usage() const noexcept;
+
+	private:
+		static constexpr size_t minimal_capacity = 1024;
+
+		double false_positive_rate;
+		size_t capacity;
+		size_t probes;
+		uint64_t mask;
+		std::vector<uint64_t> bits;
+
+		size_t inserted = 0;
+		size_t forgotten = 0;
+	};
+}
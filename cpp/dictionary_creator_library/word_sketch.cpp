@@ -0,0 +1,229 @@
+#include "word_sketch.h"
+#include "dictionary_hash.h"
+#include "dictionary_types.h"
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+	void write_number(std::ostream &stream, uint64_t number)
+	{
+		std::array<char, 8> bytes{};
+		for (size_t i = 0; i != bytes.size(); ++i)
+		{
+			bytes[i] = static_cast<char>((number >> (8 * i)) & 0xFF);
+		}
+		stream.write(bytes.data(), bytes.size());
+	}
+
+	uint64_t read_number(std::istream &stream)
+	{
+		std::array<unsigned char, 8> bytes{};
+		if (!stream.read(reinterpret_cast<char *>(bytes.data()), bytes.size()))
+		{
+			throw dictionary_creator::dictionary_runtime_error("word sketch is damaged");
+		}
+
+		uint64_t number = 0;
+		for (size_t i = 0; i != bytes.size(); ++i)
+		{
+			number |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+		}
+		return number;
+	}
+}
+
+dictionary_creator::WordSketch::WordSketch(size_t size)
+	: sketch_size{ size }
+{
+	if (sketch_size == 0)
+	{
+		throw dictionary_creator::dictionary_runtime_error("word sketch has to keep at least one hash");
+	}
+
+	hashes.reserve(2 * sketch_size + 1);
+}
+
+void dictionary_creator::WordSketch::insert(std::string_view word)
+{
+	const uint64_t hash = dictionary_creator::hash_bytes(word);
+	if (hash > threshold)
+	{
+		return;
+	}
+
+	const auto position = std::lower_bound(hashes.begin(), hashes.end(), hash);
+	if (position != hashes.end() && *position == hash)
+	{
+		return;
+	}
+
+	hashes.insert(position, hash);
+
+	// everything up to the new largest hash is still held, nothing above it is any longer
+	if (hashes.size() > 2 * sketch_size)
+	{
+		hashes.pop_back();
+		threshold = hashes.back();
+	}
+}
+
+void dictionary_creator::WordSketch::erase(std::string_view word)
+{
+	const uint64_t hash = dictionary_creator::hash_bytes(word);
+	if (hash > threshold)
+	{
+		return;
+	}
+
+	if (const auto position = std::lower_bound(hashes.begin(), hashes.end(), hash); position != hashes.end() && *position == hash)
+	{
+		hashes.erase(position);
+	}
+}
+
+void dictionary_creator::WordSketch::clear() noexcept
+{
+	hashes.clear();
+	threshold = complete;
+}
+
+bool dictionary_creator::WordSketch::needs_rebuild() const noexcept
+{
+	return threshold != complete && hashes.size() < sketch_size;
+}
+
+double dictionary_creator::WordSketch::jaccard(const dictionary_creator::WordSketch &other) const
+{
+	const auto [taken, shared, largest] = sample(other);
+
+	return taken != 0 ? static_cast<double>(shared) / static_cast<double>(taken) : 0.0;
+}
+
+double dictionary_creator::WordSketch::intersection_size(const dictionary_creator::WordSketch &other) const
+{
+	const auto [taken, shared, largest] = sample(other);
+
+	if (taken < std::min(sketch_size, other.sketch_size))
+	{
+		// both sketches hold all of their words
+		return static_cast<double>(shared);
+	}
+
+	return static_cast<double>(shared) / static_cast<double>(taken) * words_below(taken, largest);
+}
+
+double dictionary_creator::WordSketch::estimated_words() const
+{
+	if (threshold == complete)
+	{
+		return static_cast<double>(hashes.size());
+	}
+
+	const size_t taken = std::min(sketch_size, hashes.size());
+
+	return taken != 0 ? words_below(taken, hashes[taken - 1]) : 0.0;
+}
+
+void dictionary_creator::WordSketch::write(std::ostream &stream) const
+{
+	stream.write(signature, sizeof(signature));
+	write_number(stream, sketch_size);
+	write_number(stream, threshold);
+	write_number(stream, hashes.size());
+
+	for (const auto hash: hashes)
+	{
+		write_number(stream, hash);
+	}
+
+	if (!stream.good())
+	{
+		throw dictionary_creator::dictionary_runtime_error("couldn't write the word sketch");
+	}
+}
+
+dictionary_creator::WordSketch dictionary_creator::WordSketch::read(std::istream &stream)
+{
+	char read_signature[sizeof(signature)] = {};
+	if (!stream.read(read_signature, sizeof(read_signature)) || !std::equal(std::begin(signature), std::end(signature), read_signature))
+	{
+		throw dictionary_creator::dictionary_runtime_error("not a word sketch");
+	}
+
+	const auto size = read_number(stream);
+	const auto threshold = read_number(stream);
+	const auto count = read_number(stream);
+
+	if (size == 0 || size > (uint64_t{ 1 } << 24) || count > 2 * size)
+	{
+		throw dictionary_creator::dictionary_runtime_error("word sketch is damaged");
+	}
+
+	dictionary_creator::WordSketch result(static_cast<size_t>(size));
+	result.threshold = threshold;
+
+	for (uint64_t i = 0; i != count; ++i)
+	{
+		const auto hash = read_number(stream);
+		if (hash > threshold || (!result.hashes.empty() && hash <= result.hashes.back()))
+		{
+			throw dictionary_creator::dictionary_runtime_error("word sketch is damaged");
+		}
+
+		result.hashes.push_back(hash);
+	}
+
+	return result;
+}
+
+size_t dictionary_creator::WordSketch::size() const noexcept
+{
+	return sketch_size;
+}
+
+size_t dictionary_creator::WordSketch::memory_usage() const noexcept
+{
+	return hashes.capacity() * sizeof(uint64_t);
+}
+
+dictionary_creator::WordSketch::Sample dictionary_creator::WordSketch::sample(const dictionary_creator::WordSketch &other) const
+{
+	const size_t wanted = std::min(sketch_size, other.sketch_size);
+
+	Sample result{ 0, 0, 0 };
+
+	auto own = hashes.begin();
+	auto others = other.hashes.begin();
+
+	while (result.taken != wanted && (own != hashes.end() || others != other.hashes.end()))
+	{
+		if (others == other.hashes.end() || (own != hashes.end() && *own < *others))
+		{
+			result.largest = *own++;
+		}
+		else if (own == hashes.end() || *others < *own)
+		{
+			result.largest = *others++;
+		}
+		else
+		{
+			result.largest = *own++;
+			++others;
+			++result.shared;
+		}
+
+		++result.taken;
+	}
+
+	return result;
+}
+
+double dictionary_creator::WordSketch::words_below(size_t taken, uint64_t largest) noexcept
+{
+	// taken hashes spread uniformly over [0, largest] make about (taken - 1) / (largest / 2^64) of them in all
+	constexpr double hash_range = 18446744073709551616.0;
+
+	return static_cast<double>(taken - 1) * hash_range / (static_cast<double>(largest) + 1.0);
+}
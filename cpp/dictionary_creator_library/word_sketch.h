@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Bottom-k MinHash sketch of the words of one Dictionary, for estimating how much two vocabularies have in common
+// without walking either of them.
+//
+// 	-- keeps the smallest hashes of the words, up to twice the sketch size, and everything below a threshold:
+// 	   a word removed takes its hash away, the sketch asks to be rebuilt only once fewer than size() of them remain
+// 	-- jaccard() and intersection_size() look at the size() smallest hashes of both sketches together,
+// 	   the error is about 1 / sqrt(size()); sketches of fewer words than that hold all of them and are exact
+// 	-- hashes are those of dictionary_hash.h, stable between runs, so sketches written by write() compare with any others
+// 	-- write() and read() use a little-endian binary format of their own, a sketch is a few kilobytes
+
+namespace dictionary_creator
+{
+	class WordSketch
+	{
+	public:
+		static constexpr size_t default_size = 256;
+
+		explicit WordSketch(size_t size = default_size);
+
+		void insert(std::string_view word);
+		void erase(std::string_view word);
+		void clear() noexcept;
+
+		bool needs_rebuild() const noexcept;
+
+		double jaccard(const WordSketch &other) const;
+		double intersection_size(const WordSketch &other) const;
+		double estimated_words() const;
+
+		void write(std::ostream &stream) const;
+		static WordSketch read(std::istream &stream);
+
+		size_t size() const noexcept;
+		size_t memory_usage() const noexcept;
+
+	private:
+		static constexpr uint64_t complete = static_cast<uint64_t>(-1);
+		static constexpr char signature[8] = { 'D', 'C', 'S', 'K', 'T', 'C', '0', '1' };
+
+		size_t sketch_size;
+		// every hash of the dictionary not greater than the threshold, sorted
+		std::vector<uint64_t> hashes;
+		uint64_t threshold = complete;
+
+		struct Sample
+		{
+			size_t taken;
+			size_t shared;
+			uint64_t largest;
+		};
+
+		// the smallest hashes of both sketches together, how many of them both have and the largest of them
+		Sample sample(const WordSketch &other) const;
+		static double words_below(size_t taken, uint64_t largest) noexcept;
+	};
+}
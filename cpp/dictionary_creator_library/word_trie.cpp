@@ -0,0 +1,273 @@
+#include "word_trie.h"
+
+#include "dictionary.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+dictionary_creator::WordTrie::WordTrie(dictionary_creator::Language language)
+	: language{ language }, words{ 0 }, nodes(1, Node{ no_node, no_node, no_node, 0, 0 }),
+	roots{ collation_less }
+{}
+
+dictionary_creator::WordTrie::WordTrie(const dictionary_creator::Dictionary &dictionary)
+	: WordTrie(dictionary.get_language())
+{
+	for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+	{
+		for (const auto &entry: entries)
+		{
+			add_word(static_cast<const char *>(*entry), entry->get_counter());
+		}
+	}
+
+	nodes.shrink_to_fit();
+}
+
+uint32_t dictionary_creator::WordTrie::new_node(unsigned char label, uint32_t next_sibling, uint32_t parent)
+{
+	if (nodes.size() == std::numeric_limits<uint32_t>::max())
+	{
+		throw dictionary_creator::dictionary_runtime_error("word trie is out of node indices");
+	}
+
+	nodes.push_back(Node{ no_node, next_sibling, parent, 0, label });
+	return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+bool dictionary_creator::WordTrie::add_word(std::string_view word, size_t count)
+{
+	if (word.empty() || count == 0)
+	{
+		return false;
+	}
+
+	auto letter = uppercase_letter(first_letter(utf8_string{ word }, language), language);
+
+	auto root = roots.find(letter);
+	if (root == roots.end())
+	{
+		root = roots.emplace(std::move(letter), new_node(0, no_node, no_node)).first;
+	}
+
+	uint32_t current = root->second;
+
+	for (auto character: word)
+	{
+		const auto label = static_cast<unsigned char>(character);
+
+		uint32_t previous = no_node;
+		uint32_t child = nodes[current].first_child;
+
+		while (child != no_node && nodes[child].label < label)
+		{
+			previous = child;
+			child = nodes[child].next_sibling;
+		}
+
+		if (child == no_node || nodes[child].label != label)
+		{
+			auto created = new_node(label, child, current);
+
+			if (previous == no_node)
+			{
+				nodes[current].first_child = created;
+			}
+			else
+			{
+				nodes[previous].next_sibling = created;
+			}
+
+			child = created;
+		}
+
+		current = child;
+	}
+
+	auto &counter = nodes[current].counter;
+	const bool added = (counter == 0);
+
+	const auto room = static_cast<size_t>(std::numeric_limits<uint32_t>::max() - counter);
+	counter += static_cast<uint32_t>(std::min(count, room));
+
+	words += added;
+
+	if (added)
+	{
+		collated.erase(root->second);
+	}
+
+	return added;
+}
+
+bool dictionary_creator::WordTrie::remove_word(std::string_view word)
+{
+	if (auto node = find_node(word); node != no_node && nodes[node].counter != 0)
+	{
+		nodes[node].counter = 0;
+		--words;
+		return true;
+	}
+
+	return false;
+}
+
+const std::vector<uint32_t> &dictionary_creator::WordTrie::collated_ends(uint32_t root) const
+{
+	if (auto cached = collated.find(root); cached != collated.end())
+	{
+		return cached->second;
+	}
+
+	std::vector<std::pair<dictionary_creator::utf8_string, uint32_t>> ends;
+	dictionary_creator::utf8_string word;
+	gather_ends(nodes[root].first_child, word, ends);
+
+	// sort keys come first, words break ties between equal keys, as DefaultEntrySorter has it
+	std::vector<std::tuple<dictionary_creator::utf8_string, dictionary_creator::utf8_string, uint32_t>> keyed;
+	keyed.reserve(ends.size());
+	for (auto &[end_word, end]: ends)
+	{
+		keyed.emplace_back(dictionary_creator::collation_key(end_word), std::move(end_word), end);
+	}
+
+	std::sort(keyed.begin(), keyed.end());
+
+	std::vector<uint32_t> order;
+	order.reserve(keyed.size());
+	for (const auto &[key, end_word, end]: keyed)
+	{
+		order.push_back(end);
+	}
+
+	return collated.emplace(root, std::move(order)).first->second;
+}
+
+void dictionary_creator::WordTrie::gather_ends(uint32_t node, dictionary_creator::utf8_string &word,
+	std::vector<std::pair<dictionary_creator::utf8_string, uint32_t>> &ends) const
+{
+	for (; node != no_node; node = nodes[node].next_sibling)
+	{
+		word.push_back(static_cast<char>(nodes[node].label));
+
+		if (nodes[node].counter != 0)
+		{
+			ends.emplace_back(word, node);
+		}
+		gather_ends(nodes[node].first_child, word, ends);
+
+		word.pop_back();
+	}
+}
+
+void dictionary_creator::WordTrie::spell(uint32_t end, dictionary_creator::utf8_string &word) const
+{
+	word.clear();
+
+	// the root of a letter has no parent and no label of its own
+	for (auto node = end; nodes[node].parent != no_node; node = nodes[node].parent)
+	{
+		word.push_back(static_cast<char>(nodes[node].label));
+	}
+
+	std::reverse(word.begin(), word.end());
+}
+
+uint32_t dictionary_creator::WordTrie::find_node(std::string_view word) const noexcept
+{
+	if (word.empty())
+	{
+		return no_node;
+	}
+
+	// a letter takes four bytes at most, copying no more than that of the word keeps it in the small string buffer
+	const auto letter = try_uppercase_letter(first_letter(utf8_string{ word.substr(0, 4) }, language), language);
+	if (!letter)
+	{
+		return no_node;
+	}
+
+	auto root = roots.find(*letter);
+	if (root == roots.end())
+	{
+		return no_node;
+	}
+
+	uint32_t current = root->second;
+
+	for (auto character: word)
+	{
+		const auto label = static_cast<unsigned char>(character);
+
+		uint32_t child = nodes[current].first_child;
+		while (child != no_node && nodes[child].label < label)
+		{
+			child = nodes[child].next_sibling;
+		}
+
+		if (child == no_node || nodes[child].label != label)
+		{
+			return no_node;
+		}
+
+		current = child;
+	}
+
+	return current;
+}
+
+bool dictionary_creator::WordTrie::contains_word(std::string_view word) const noexcept
+{
+	return get_counter(word) != 0;
+}
+
+size_t dictionary_creator::WordTrie::get_counter(std::string_view word) const noexcept
+{
+	auto node = find_node(word);
+
+	return node != no_node ? nodes[node].counter : 0;
+}
+
+size_t dictionary_creator::WordTrie::total_words() const noexcept
+{
+	return words;
+}
+
+std::vector<dictionary_creator::letter_type> dictionary_creator::WordTrie::get_letters() const
+{
+	std::vector<dictionary_creator::letter_type> letters;
+	letters.reserve(roots.size());
+
+	for (const auto &[letter, root]: roots)
+	{
+		letters.push_back(letter);
+	}
+
+	return letters;
+}
+
+size_t dictionary_creator::WordTrie::memory_usage() const noexcept
+{
+	constexpr size_t map_node_overhead = 4 * sizeof(void *);
+	constexpr size_t hash_node_overhead = 2 * sizeof(void *);
+
+	size_t result = sizeof(*this) + nodes.capacity() * sizeof(Node);
+
+	for (const auto &[letter, root]: roots)
+	{
+		result += map_node_overhead + sizeof(letter) + sizeof(root);
+	}
+
+	for (const auto &[root, ends]: collated)
+	{
+		result += hash_node_overhead + sizeof(root) + sizeof(ends) + ends.capacity() * sizeof(uint32_t);
+	}
+
+	return result;
+}
+
+dictionary_creator::Language dictionary_creator::WordTrie::get_language() const noexcept
+{
+	return language;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "dictionary_types.h"
+#include "dictionary_language.h"
+
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Compact alternative to the Entry-per-word layout of Dictionary, meant for large vocabularies
+// where words share prefixes heavily (russian or german inflections).
+//
+// 	-- one trie per first letter, letters are normalized and ordered as Dictionary does it
+// 	-- nodes live in a single vector and refer to each other, and to their parent, by 32-bit indices
+// 	-- children are kept sorted by byte value, which is not the collation order of the words: case and diacritics only
+// 	   break ties there, so the first for_each_in_letter() of a letter sorts the nodes its words end at once and keeps
+// 	   that order until a word new to the letter is added; words are spelled from their end nodes upwards
+// 	-- iterating fills that cache, so iterations running concurrently need a lock of their own
+// 	-- counters are attached to the terminal nodes, a zero counter means no word ends there
+
+namespace dictionary_creator
+{
+	class Dictionary;
+
+	class WordTrie
+	{
+	public:
+		explicit WordTrie(Language language);
+		explicit WordTrie(const Dictionary &dictionary);
+
+		bool add_word(std::string_view word, size_t count = 1);
+		bool remove_word(std::string_view word);
+
+		bool contains_word(std::string_view word) const noexcept;
+		size_t get_counter(std::string_view word) const noexcept;
+		size_t total_words() const noexcept;
+
+		std::vector<letter_type> get_letters() const;
+
+		template <typename Callback>
+		void for_each_in_letter(letter_type letter, Callback &&callback) const
+		{
+			// a letter of another alphabet has no words either
+			const auto uppercase = try_uppercase_letter(std::move(letter), language);
+			if (!uppercase)
+			{
+				return;
+			}
+
+			auto root = roots.find(*uppercase);
+			if (root == roots.end())
+			{
+				return;
+			}
+
+			utf8_string word;
+			for (auto end: collated_ends(root->second))
+			{
+				// removed words keep their place in the order, with a zero counter
+				if (nodes[end].counter != 0)
+				{
+					spell(end, word);
+					callback(static_cast<const utf8_string &>(word), static_cast<size_t>(nodes[end].counter));
+				}
+			}
+		}
+
+		size_t memory_usage() const noexcept;
+		Language get_language() const noexcept;
+
+	private:
+		struct Node
+		{
+			uint32_t first_child;
+			uint32_t next_sibling;
+			uint32_t parent;
+			uint32_t counter;
+			unsigned char label;
+		};
+
+		static constexpr uint32_t no_node = 0;
+
+		uint32_t find_node(std::string_view word) const noexcept;
+		uint32_t new_node(unsigned char label, uint32_t next_sibling, uint32_t parent);
+
+		// the nodes words of the letter end at, in the order of Dictionary
+		const std::vector<uint32_t> &collated_ends(uint32_t root) const;
+		void gather_ends(uint32_t node, utf8_string &word, std::vector<std::pair<utf8_string, uint32_t>> &ends) const;
+		void spell(uint32_t end, utf8_string &word) const;
+
+		Language language;
+		size_t words;
+		std::vector<Node> nodes;
+		std::map<letter_type, uint32_t, string_comp> roots;
+		mutable std::unordered_map<uint32_t, std::vector<uint32_t>> collated;
+	};
+}
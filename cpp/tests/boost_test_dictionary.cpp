@@ -5,6 +5,9 @@
 #include "dictionary_definer.h"
 #include "dictionary_exporter.h"
 
+#include <cmath>
+#include <memory_resource>
+
 #if defined(_MSC_VER)
 #define DELIBERATELY_SUBOPTIMAL(code)                     \
 __pragma(warning(push))                                   \
@@ -466,6 +469,29 @@ BOOST_AUTO_TEST_SUITE(dictionary_alltogether)
 			eng.add_word<DifficultyEntry>("pun", 0.1);
 			BOOST_TEST_CHECK(dynamic_cast<DifficultyEntry *>(eng.get_top(get_comp_less_difficult(), 6).back().get()) != nullptr);
 		}
+
+		BOOST_TEST_CONTEXT("get_top<T>() with a plain callable")
+		{
+			class HarderEntry : public DifficultyEntry
+			{
+			public:
+				using DifficultyEntry::DifficultyEntry;
+			};
+
+			eng.add_word<HarderEntry>("thumb", 0.11);
+
+			auto by_lambda = eng.get_top<DifficultyEntry>([] (const DifficultyEntry &a, const DifficultyEntry &b)
+				{ return a.get_difficulty() < b.get_difficulty(); }, 10);
+
+			BOOST_TEST_INFO("same as through std::function, entries of derived types included");
+			BOOST_TEST_CHECK(by_lambda == eng.get_top(get_comp_less_difficult(), 10));
+			BOOST_TEST_CHECK(by_lambda[2]->get_word() == "thumb");
+
+			BOOST_TEST_INFO("entries of other types follow in the order of their words");
+			BOOST_TEST_CHECK(by_lambda[7]->get_word() == "arcbishop");
+			BOOST_TEST_CHECK(by_lambda[8]->get_word() == "bomb");
+			BOOST_TEST_CHECK(by_lambda[9]->get_word() == "cat");
+		}
 	}
 
 	BOOST_FIXTURE_TEST_CASE(big_five, DictionaryObjects)
@@ -1070,4 +1096,1136 @@ BOOST_AUTO_TEST_SUITE(dictionary_alltogether)
 		}
 	}
 
+	BOOST_AUTO_TEST_CASE(collation_order)
+	{
+		auto words_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			std::vector<dictionary_creator::utf8_string> words;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					words.push_back(entry->get_word());
+				}
+			}
+			return words;
+		};
+
+		using words = std::vector<dictionary_creator::utf8_string>;
+
+		BOOST_TEST_CONTEXT("diacritics only matter between otherwise equal words")
+		{
+			dictionary_creator::Dictionary fra(dictionary_creator::Language::French);
+			for (auto word: { u8"côté", u8"zèbre", u8"coté", u8"cote", u8"côte", u8"cotes", u8"écran", u8"eau", u8"école", u8"fête" })
+			{
+				fra.add_word(word);
+			}
+
+			BOOST_TEST_CHECK(words_of(fra) == (words{ u8"cote", u8"coté", u8"côte", u8"côté", u8"cotes",
+				u8"eau", u8"école", u8"écran", u8"fête", u8"zèbre" }));
+			BOOST_TEST_CHECK(fra.lookup(u8"côte").get() != nullptr);
+			BOOST_TEST_CHECK(fra.lookup(u8"cöte").get() == nullptr);
+		}
+
+		BOOST_TEST_CONTEXT("ё is sorted as е with a diacritic")
+		{
+			dictionary_creator::Dictionary rus(dictionary_creator::Language::Russian);
+			for (auto word: { u8"жесть", u8"ёжик", u8"ежевика", u8"елка", u8"ёлка", u8"еда", u8"йогурт", u8"истина" })
+			{
+				rus.add_word(word);
+			}
+
+			BOOST_TEST_CHECK(words_of(rus) == (words{ u8"еда", u8"ежевика", u8"елка", u8"ёжик", u8"ёлка", u8"жесть", u8"истина", u8"йогурт" }));
+			BOOST_TEST_CHECK(rus.remove_word(u8"ёлка"));
+			BOOST_TEST_CHECK(rus.lookup(u8"елка").get() != nullptr);
+		}
+
+		BOOST_TEST_CONTEXT("case and digits")
+		{
+			dictionary_creator::Dictionary deu(dictionary_creator::Language::German);
+			for (auto word: { u8"Straße", u8"Strasse", u8"strasse", u8"Äpfel", u8"Apfel", u8"Zug", u8"über", u8"Ufer" })
+			{
+				deu.add_word(word);
+			}
+
+			BOOST_TEST_CHECK(words_of(deu) == (words{ u8"Apfel", u8"Äpfel", u8"strasse", u8"Strasse", u8"Straße",
+				u8"Ufer", u8"über", u8"Zug" }));
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(letter_map)
+	{
+		dictionary_creator::LetterMap<std::vector<int>> letters;
+
+		BOOST_TEST_CHECK(letters.empty());
+		BOOST_CHECK_THROW(letters.at("A"), std::out_of_range);
+
+		auto &first = letters[u8"Ж"];
+		first.push_back(1);
+
+		for (auto letter: { u8"Е", u8"Ω", u8"Ё", "1", u8"А", "Z", u8"É", "E", u8"Œ" })
+		{
+			letters[letter].push_back(2);
+		}
+
+		BOOST_TEST_INFO("references survive the insertion of new letters");
+		BOOST_TEST_CHECK(&first == &letters.at(u8"Ж"));
+		BOOST_TEST_CHECK(letters[u8"Ж"].size() == 1u);
+		BOOST_TEST_CHECK(letters.size() == 10u);
+
+		std::vector<dictionary_creator::letter_type> order;
+		for (const auto &[letter, bucket]: letters)
+		{
+			order.push_back(letter);
+		}
+
+		BOOST_TEST_INFO("iteration follows the alphabet, letters out of the table included");
+		BOOST_TEST_CHECK(order == (std::vector<dictionary_creator::letter_type>{ "1", "E", u8"É", u8"Œ", "Z", u8"А", u8"Е", u8"Ё", u8"Ж", u8"Ω" }));
+
+		BOOST_TEST_CHECK((letters.find(u8"Ω") != letters.end()));
+		BOOST_TEST_CHECK((letters.find(u8"Ψ") == letters.end()));
+
+		BOOST_TEST_CONTEXT("copies are independent")
+		{
+			auto copy = letters;
+			copy[u8"Ψ"].push_back(3);
+			copy.at("E").clear();
+
+			BOOST_TEST_CHECK(copy.size() == 11u);
+			BOOST_TEST_CHECK(letters.size() == 10u);
+			BOOST_TEST_CHECK(letters.at("E").size() == 1u);
+
+			letters = std::move(copy);
+			BOOST_TEST_CHECK(letters.at(u8"Ψ").size() == 1u);
+			BOOST_TEST_CHECK(copy.empty());
+			BOOST_TEST_CHECK((copy.find("E") == copy.end()));
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(probing_absent_words)
+	{
+		dictionary_creator::Dictionary russian(dictionary_creator::Language::Russian);
+		russian.add_word(u8"слово");
+
+		BOOST_TEST_INFO("a word of another alphabet is a miss, not an error");
+		BOOST_TEST_CHECK(russian.lookup("word") == nullptr);
+		BOOST_TEST_CHECK(russian.lookup("") == nullptr);
+		BOOST_TEST_CHECK(russian.remove_word("word") == false);
+		BOOST_TEST_CHECK(russian.get_completions("wo", 10).empty());
+		BOOST_TEST_CHECK(russian.probe_first_letter("word").has_value() == false);
+		BOOST_TEST_CHECK(russian.get_letter_entries("w").empty());
+		BOOST_CHECK_THROW(russian.get_first_letter("word"), std::runtime_error);
+
+		BOOST_TEST_INFO("so is a word under a letter the dictionary lacks");
+		BOOST_TEST_CHECK(russian.lookup(u8"дело") == nullptr);
+		BOOST_TEST_CHECK(russian.remove_word(u8"дело") == false);
+		BOOST_TEST_CHECK(russian.get_letter_entries(u8"д").empty());
+		BOOST_TEST_CHECK(russian.get_main_dictionary().size() == 1u);
+		BOOST_TEST_CHECK(*russian.probe_first_letter(u8"дело") == u8"Д");
+
+		BOOST_TEST_CHECK(russian.lookup(u8"слово") != nullptr);
+		BOOST_TEST_CHECK(russian.remove_word(u8"слово"));
+		BOOST_TEST_CHECK(russian.lookup(u8"слово") == nullptr);
+	}
+
+	BOOST_AUTO_TEST_CASE(incremental_proper_nouns)
+	{
+		using words = std::set<dictionary_creator::utf8_string>;
+
+		auto words_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			words result;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.insert(entry->get_word());
+				}
+			}
+			return result;
+		};
+
+		auto word = [] (size_t i) { return dictionary_creator::utf8_string{ static_cast<char>('a' + i % 7), static_cast<char>('a' + i / 7 % 7) }; };
+
+		BOOST_TEST_CONTEXT("merges line by line end up as a single rescan would")
+		{
+			std::srand(17);
+
+			dictionary_creator::Dictionary accumulated(dictionary_creator::Language::English);
+			words added, proper;
+
+			for (size_t line = 0; line != 300; ++line)
+			{
+				dictionary_creator::Dictionary parsed(dictionary_creator::Language::English);
+
+				for (size_t i = 0; i != 5; ++i)
+				{
+					auto current = word(dictionary_creator::random_number(49));
+					parsed.add_word(current);
+					added.insert(current);
+				}
+
+				if (dictionary_creator::random_number(4) == 0)
+				{
+					auto current = word(dictionary_creator::random_number(49));
+					parsed.add_proper_noun(current);
+					proper.insert(current);
+				}
+
+				if (line % 2 == 0)
+				{
+					accumulated.merge(std::move(parsed));
+				}
+				else
+				{
+					accumulated.merge(parsed);
+				}
+
+				if (dictionary_creator::random_number(5) == 0)
+				{
+					auto current = word(dictionary_creator::random_number(49));
+					accumulated.add_proper_noun(current);
+					proper.insert(current);
+				}
+
+				if (dictionary_creator::random_number(5) == 0)
+				{
+					auto current = word(dictionary_creator::random_number(49));
+					accumulated.add_word(current);
+					added.insert(current);
+				}
+			}
+
+			accumulated.remove_proper_nouns();
+
+			words expected;
+			std::set_difference(added.begin(), added.end(), proper.begin(), proper.end(), std::inserter(expected, expected.end()));
+
+			BOOST_TEST_CHECK(words_of(accumulated) == expected);
+		}
+
+		BOOST_TEST_CONTEXT("words added after a proper noun are caught, however many of them")
+		{
+			dictionary_creator::Dictionary object(dictionary_creator::Language::English);
+			object.add_proper_noun("bb");
+			object.add_proper_noun("cc");
+			object.remove_proper_nouns();
+
+			for (size_t i = 0; i != 49; ++i)
+			{
+				object.add_word(word(i));
+			}
+
+			BOOST_TEST_CHECK(object.total_words() == 49u);
+			object.remove_proper_nouns();
+			BOOST_TEST_CHECK(object.total_words() == 47u);
+			BOOST_TEST_CHECK(object.lookup("bb") == nullptr);
+			BOOST_TEST_CHECK(object.lookup("cc") == nullptr);
+		}
+	}
+
+	BOOST_FIXTURE_TEST_CASE(copy_on_write, DictionaryObjects)
+	{
+		const auto &buckets = eng.get_main_dictionary();
+		const auto love_counter = eng.lookup("love")->get_counter();
+
+		BOOST_TEST_CONTEXT("copies share buckets and entries until they change")
+		{
+			auto copy = eng;
+			BOOST_TEST_CHECK(buckets.at("L").is_shared());
+			BOOST_TEST_CHECK(copy.lookup("love") == eng.lookup("love"));
+
+			copy.add_word("love");
+			copy.add_word("lovely");
+
+			BOOST_TEST_CHECK(copy.lookup("love")->get_counter() == love_counter + 1);
+			BOOST_TEST_CHECK(eng.lookup("love")->get_counter() == love_counter);
+			BOOST_TEST_CHECK(eng.lookup("lovely") == nullptr);
+
+			BOOST_TEST_INFO("only the touched bucket is cloned");
+			BOOST_TEST_CHECK(buckets.at("L").is_shared() == false);
+			BOOST_TEST_CHECK(buckets.at("M").is_shared());
+			BOOST_TEST_CHECK(copy.lookup("misery") == eng.lookup("misery"));
+
+			copy.remove_word("misery");
+			BOOST_TEST_CHECK(eng.lookup("misery") != nullptr);
+			BOOST_TEST_CHECK(buckets.at("N").is_shared());
+		}
+
+		BOOST_TEST_INFO("buckets are exclusive once copies are gone");
+		BOOST_TEST_CHECK(buckets.at("N").is_shared() == false);
+
+		BOOST_TEST_CONTEXT("entries merged from an lvalue aren't changed through the receiver")
+		{
+			dictionary_creator::Dictionary other(dictionary_creator::Language::English);
+			other.add_word("love");
+			other.merge(eng);
+
+			BOOST_TEST_CHECK(other.lookup("love")->get_counter() == love_counter + 1);
+			BOOST_TEST_CHECK(eng.lookup("love")->get_counter() == love_counter);
+
+			other.add_word("misery");
+			BOOST_TEST_CHECK(other.lookup("misery")->get_counter() == eng.lookup("misery")->get_counter() + 1);
+
+			eng.merge(other);
+			BOOST_TEST_CHECK(eng.lookup("love")->get_counter() == 2 * love_counter + 1);
+			BOOST_TEST_CHECK(other.lookup("love")->get_counter() == love_counter + 1);
+		}
+
+		BOOST_TEST_CONTEXT("operators taking copies leave their operands intact")
+		{
+			dictionary_creator::Dictionary addition(dictionary_creator::Language::English);
+			addition.add_word("grace");
+
+			auto before = eng.total_words();
+			auto sum = eng + addition;
+			sum.add_word("misery");
+
+			BOOST_TEST_CHECK(eng.total_words() == before);
+			BOOST_TEST_CHECK(sum.lookup("misery")->get_counter() == eng.lookup("misery")->get_counter() + 1);
+		}
+	}
+
+	BOOST_FIXTURE_TEST_CASE(memory_usage, DictionaryObjects)
+	{
+		BOOST_TEST_INFO("empty dictionary takes no heap memory");
+		auto empty = dictionary_creator::Dictionary(dictionary_creator::Language::English).memory_usage();
+		BOOST_TEST_CHECK(empty.overall.total() == 0u);
+		BOOST_TEST_CHECK(empty.letters.empty());
+
+		auto report = eng.memory_usage();
+		BOOST_TEST_CHECK(report.letters.size() == english_words.size());
+		BOOST_TEST_CHECK(report.overall.entries >= english_words.size() * sizeof(dictionary_creator::Entry));
+		BOOST_TEST_CHECK(report.overall.container_nodes > 0u);
+		BOOST_TEST_CHECK(report.overall.definitions == 0u);
+		BOOST_TEST_CHECK(report.overall.proper_nouns == 0u);
+
+		size_t letters_total = 0;
+		for (const auto &[letter, usage]: report.letters)
+		{
+			letters_total += usage.total();
+		}
+		BOOST_TEST_CHECK(letters_total == report.overall.total());
+
+		BOOST_TEST_INFO("long words keep their letters on the heap");
+		BOOST_TEST_CHECK(rus.memory_usage().letters.at(u8"П").word_strings > 0u);
+
+		BOOST_TEST_CONTEXT("definitions are accounted to their letter")
+		{
+			eng.lookup("love")->define(fake_definer);
+			auto defined = eng.memory_usage();
+
+			BOOST_TEST_CHECK(defined.overall.definitions > 0u);
+			BOOST_TEST_CHECK(defined.letters.at("L").definitions == defined.overall.definitions);
+			BOOST_TEST_CHECK(defined.letters.at("M").total() == report.letters.at("M").total());
+		}
+
+		BOOST_TEST_CONTEXT("proper nouns")
+		{
+			eng.add_proper_noun("bill");
+			auto with_proper_nouns = eng.memory_usage();
+
+			BOOST_TEST_CHECK(with_proper_nouns.overall.proper_nouns > 0u);
+			BOOST_TEST_CHECK(with_proper_nouns.letters.at("B").proper_nouns == with_proper_nouns.overall.proper_nouns);
+		}
+
+		BOOST_TEST_CONTEXT("footprint follows the number of words")
+		{
+			auto before = eng.memory_usage().overall.total();
+			eng.add_word("lovely");
+			BOOST_TEST_CHECK(eng.memory_usage().overall.total() > before);
+			eng.remove_word("lovely");
+			BOOST_TEST_CHECK(eng.memory_usage().overall.total() == before);
+		}
+	}
+
+	BOOST_FIXTURE_TEST_CASE(bulk_construction, DictionaryObjects)
+	{
+		using counted_words = std::vector<std::pair<dictionary_creator::utf8_string, size_t>>;
+
+		auto counted_words_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			counted_words result;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.emplace_back(entry->get_word(), entry->get_counter());
+				}
+			}
+			return result;
+		};
+
+		eng.add_word("love");
+		eng.add_word("love");
+		const auto expected = counted_words_of(eng);
+
+		BOOST_TEST_CONTEXT("(word, counter) pairs in order")
+		{
+			auto built = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, expected.begin(), expected.end());
+			BOOST_TEST_CHECK(counted_words_of(built) == expected);
+			BOOST_TEST_CHECK(built.total_words() == eng.total_words());
+			BOOST_TEST_CHECK(built.lookup("love")->get_counter() == 3u);
+		}
+
+		BOOST_TEST_CONTEXT("(word, counter) pairs in any order")
+		{
+			const counted_words reversed(expected.rbegin(), expected.rend());
+			auto built = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, reversed.begin(), reversed.end());
+			BOOST_TEST_CHECK(counted_words_of(built) == expected);
+
+			const std::map<dictionary_creator::utf8_string, int> bytewise{ { "b", 1 }, { "B", 2 }, { "a", 3 } };
+			auto from_map = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, bytewise.begin(), bytewise.end());
+			BOOST_TEST_CHECK(counted_words_of(from_map) == (counted_words{ { "a", 3 }, { "b", 1 }, { "B", 2 } }));
+		}
+
+		BOOST_TEST_CONTEXT("repeated words")
+		{
+			const counted_words repeated{ { "one", 2 }, { "one", 3 }, { "two", 1 }, { "one", 1 } };
+			auto built = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, repeated.begin(), repeated.end());
+			BOOST_TEST_CHECK(counted_words_of(built) == (counted_words{ { "one", 6 }, { "two", 1 } }));
+		}
+
+		BOOST_TEST_CONTEXT("entries")
+		{
+			dictionary_creator::subset_t entries;
+			for (const auto &[letter, words]: rus.get_main_dictionary())
+			{
+				entries.insert(entries.end(), words.begin(), words.end());
+			}
+
+			auto built = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::Russian, entries.begin(), entries.end());
+			BOOST_TEST_CHECK(counted_words_of(built) == counted_words_of(rus));
+			BOOST_TEST_CHECK(built.lookup(entries.front()->get_word()) == entries.front());
+
+			BOOST_TEST_INFO("entries held elsewhere are copied before their counters change");
+			const auto counter = entries.front()->get_counter();
+			dictionary_creator::subset_t twice{ entries.front(), entries.front() };
+			auto doubled = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::Russian, twice.begin(), twice.end());
+			BOOST_TEST_CHECK(doubled.lookup(entries.front()->get_word())->get_counter() == 2 * counter);
+			BOOST_TEST_CHECK(entries.front()->get_counter() == counter);
+		}
+
+		BOOST_TEST_CONTEXT("empty input")
+		{
+			const counted_words nothing;
+			BOOST_TEST_CHECK(dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, nothing.begin(), nothing.end()).total_words() == 0u);
+		}
+
+		BOOST_TEST_CONTEXT("counters below one")
+		{
+			const std::vector<std::pair<std::string, size_t>> unseen{ { "one", 1 }, { "two", 0 } };
+			BOOST_CHECK_THROW(dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, unseen.begin(), unseen.end()),
+				dictionary_creator::dictionary_runtime_error);
+
+			const std::vector<std::pair<std::string, int>> negative{ { "one", -1 } };
+			BOOST_CHECK_THROW(dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, negative.begin(), negative.end()),
+				dictionary_creator::dictionary_runtime_error);
+
+			const std::vector<std::pair<std::string, int>> signed_counters{ { "one", 3 } };
+			BOOST_TEST_CHECK(dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, signed_counters.begin(), signed_counters.end())
+				.lookup("one")->get_counter() == 3u);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(merge_join)
+	{
+		using counted_words = std::map<dictionary_creator::utf8_string, size_t>;
+
+		auto counted_words_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			counted_words result;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.emplace(entry->get_word(), entry->get_counter());
+				}
+			}
+			return result;
+		};
+
+		auto dictionary_of = [] (const counted_words &words)
+		{
+			return dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, words.begin(), words.end());
+		};
+
+		// every third word of the large one is shared, the small one is looked up rather than walked
+		counted_words large, small{ { "apple", 1 }, { "word0", 5 }, { "word999", 2 } }, half;
+		for (size_t i = 0; i != 3000; ++i)
+		{
+			large.emplace("word" + std::to_string(i), i % 7 + 1);
+			if (i % 3 == 0)
+			{
+				half.emplace("word" + std::to_string(i * 2), 1);
+			}
+		}
+
+		for (const auto &[left, right]: { std::pair{ large, small }, std::pair{ small, large }, std::pair{ large, half }, std::pair{ half, large } })
+		{
+			BOOST_TEST_CONTEXT(left.size() << " words with " << right.size() << " words")
+			{
+				counted_words sum = left, difference = left, intersection;
+				for (const auto &[word, counter]: right)
+				{
+					sum[word] += counter;
+					difference.erase(word);
+					// undefined words of the left side give way to those of the right one
+					if (left.count(word) != 0)
+					{
+						intersection.emplace(word, counter);
+					}
+				}
+
+				BOOST_TEST_CHECK(counted_words_of(dictionary_of(left) + dictionary_of(right)) == sum);
+				BOOST_TEST_CHECK(counted_words_of(dictionary_of(left).merge(dictionary_of(right))) == sum);
+				BOOST_TEST_CHECK(counted_words_of(dictionary_of(left) - dictionary_of(right)) == difference);
+				BOOST_TEST_CHECK(counted_words_of(dictionary_of(left).subtract(dictionary_of(right))) == difference);
+				BOOST_TEST_CHECK(counted_words_of(dictionary_of(left) * dictionary_of(right)) == intersection);
+
+				BOOST_TEST_INFO("copies sharing buckets and entries are left untouched");
+				auto merged = dictionary_of(left);
+				const auto copy = merged;
+				merged += dictionary_of(right);
+				BOOST_TEST_CHECK(counted_words_of(merged) == sum);
+				BOOST_TEST_CHECK(counted_words_of(copy) == left);
+			}
+		}
+
+		BOOST_TEST_CONTEXT("merging into itself")
+		{
+			auto doubled = dictionary_of(small);
+			const auto copy = doubled;
+			doubled.merge(doubled);
+			BOOST_TEST_CHECK(counted_words_of(doubled) == (counted_words{ { "apple", 2 }, { "word0", 10 }, { "word999", 4 } }));
+			BOOST_TEST_CHECK(counted_words_of(copy) == small);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(parallel_set_algebra)
+	{
+		using counted_words = std::map<dictionary_creator::utf8_string, size_t>;
+
+		auto counted_words_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			counted_words result;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.emplace(entry->get_word(), entry->get_counter());
+				}
+			}
+			return result;
+		};
+
+		// buckets of every size, a few letters hold most of the words
+		auto dictionary_of = [] (size_t first, size_t last)
+		{
+			dictionary_creator::Dictionary result(dictionary_creator::Language::English);
+			for (size_t i = first; i != last; ++i)
+			{
+				const char letter = static_cast<char>('a' + (i % 7 == 0 ? i % 26 : i % 3));
+				result.add_word(letter + std::to_string(i));
+			}
+			result.add_word("Boston");
+			return result;
+		};
+
+		auto left = dictionary_of(0, 4000);
+		auto right = dictionary_of(2000, 6000);
+		right.add_proper_noun("Boston");
+		left.enable_prefix_index();
+		left.enable_word_filter();
+
+		dictionary_creator::ThreadPool pool(4);
+
+		BOOST_TEST_CONTEXT("merge")
+		{
+			auto sequential = left, parallel = left;
+			sequential.merge(right);
+			parallel.merge(right, pool);
+
+			BOOST_TEST_CHECK(counted_words_of(parallel) == counted_words_of(sequential));
+			BOOST_TEST_CHECK(parallel.lookup("Boston") == nullptr);
+			BOOST_TEST_CHECK(parallel.lookup("a5202") != nullptr);
+			BOOST_TEST_CHECK(parallel.get_completions("a52", 100).size() == sequential.get_completions("a52", 100).size());
+			BOOST_TEST_CHECK(parallel.get_completions("a2", 1).front()->get_counter() == 2u);
+		}
+
+		BOOST_TEST_CONTEXT("subtract")
+		{
+			auto sequential = left, parallel = left;
+			sequential.subtract(right);
+			parallel.subtract(right, pool);
+
+			BOOST_TEST_CHECK(counted_words_of(parallel) == counted_words_of(sequential));
+			BOOST_TEST_CHECK(parallel.lookup("a3000") == nullptr);
+			BOOST_TEST_CHECK(parallel.get_completions("a30", 100).size() == sequential.get_completions("a30", 100).size());
+
+			parallel.subtract(parallel, pool);
+			BOOST_TEST_CHECK(parallel.total_words() == 0u);
+		}
+
+		BOOST_TEST_CONTEXT("intersection")
+		{
+			BOOST_TEST_CHECK(counted_words_of(left.intersection_with(right, pool)) == counted_words_of(left.intersection_with(right)));
+			BOOST_TEST_CHECK(right.intersection_with(left, pool).total_words() == right.intersection_with(left).total_words());
+		}
+
+		BOOST_TEST_CONTEXT("language mismatch")
+		{
+			dictionary_creator::Dictionary russian(dictionary_creator::Language::Russian);
+			BOOST_CHECK_THROW(left.merge(russian, pool), dictionary_creator::dictionary_runtime_error);
+			BOOST_CHECK_THROW(left.subtract(russian, pool), dictionary_creator::dictionary_runtime_error);
+			BOOST_CHECK_THROW(left.intersection_with(russian, pool), dictionary_creator::dictionary_runtime_error);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(merge_all)
+	{
+		using counted_words = std::map<dictionary_creator::utf8_string, size_t>;
+
+		auto counted_words_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			counted_words result;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.emplace(entry->get_word(), entry->get_counter());
+				}
+			}
+			return result;
+		};
+
+		std::vector<dictionary_creator::Dictionary> parts;
+		for (size_t part = 0; part != 7; ++part)
+		{
+			parts.emplace_back(dictionary_creator::Language::English);
+			for (size_t i = 0; i < 300; i += part + 1)
+			{
+				parts.back().add_word((i % 2 ? "a" : "b") + std::to_string(i));
+			}
+		}
+		parts[2].add_word("Paris");
+		parts[5].add_word("zebra");
+		parts[5].add_word("zebra");
+		parts[6].add_proper_noun("Paris");
+
+		dictionary_creator::Dictionary folded(dictionary_creator::Language::English);
+		for (const auto &part: parts)
+		{
+			folded += part;
+		}
+
+		const auto merged = dictionary_creator::Dictionary::merge_all(parts);
+
+		BOOST_TEST_CHECK(counted_words_of(merged) == counted_words_of(folded));
+		BOOST_TEST_CHECK(merged.lookup("Paris") == nullptr);
+		BOOST_TEST_CHECK(merged.lookup("b0")->get_counter() == 7u);
+		BOOST_TEST_CHECK(merged.get_proper_nouns_dictionary().at("P").size() == 1u);
+
+		BOOST_TEST_INFO("inputs stay as they were, words of a single dictionary are shared with it");
+		BOOST_TEST_CHECK(parts[0].lookup("b0")->get_counter() == 1u);
+		BOOST_TEST_CHECK(parts[2].lookup("Paris") != nullptr);
+		BOOST_TEST_CHECK(merged.lookup("zebra") == parts[5].lookup("zebra"));
+
+		BOOST_TEST_INFO("the dictionary given first keeps its entry of a word");
+		dictionary_creator::Dictionary defined(dictionary_creator::Language::English);
+		defined.add_word("b0");
+		const auto single = dictionary_creator::Dictionary::merge_all(std::vector<const dictionary_creator::Dictionary *>{ &defined, &parts[0], &parts[1] });
+		BOOST_TEST_CHECK(single.lookup("b0")->get_counter() == 3u);
+		BOOST_TEST_CHECK(defined.lookup("b0")->get_counter() == 1u);
+
+		BOOST_CHECK_THROW(dictionary_creator::Dictionary::merge_all(std::vector<dictionary_creator::Dictionary>{}), dictionary_creator::dictionary_runtime_error);
+		parts.emplace_back(dictionary_creator::Language::Russian);
+		BOOST_CHECK_THROW(dictionary_creator::Dictionary::merge_all(parts), dictionary_creator::dictionary_runtime_error);
+	}
+
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t outstanding = 0;
+		size_t allocations = 0;
+
+	private:
+		void *do_allocate(size_t bytes, size_t alignment) override
+		{
+			outstanding += bytes;
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void *pointer, size_t bytes, size_t alignment) override
+		{
+			outstanding -= bytes;
+			std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	BOOST_AUTO_TEST_CASE(memory_resource)
+	{
+		CountingResource counting;
+
+		BOOST_TEST_CHECK(dictionary_creator::Dictionary(dictionary_creator::Language::English).get_memory_resource() == std::pmr::get_default_resource());
+
+		BOOST_TEST_CONTEXT("everything is allocated by the resource and given back to it")
+		{
+			{
+				dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English, &counting);
+				for (auto word: english_words)
+				{
+					dictionary.add_word(word);
+				}
+				dictionary.add_proper_noun("Bill");
+				BOOST_TEST_CHECK(counting.allocations >= 2 * english_words.size());
+
+				auto copy = dictionary;
+				BOOST_TEST_CHECK(copy.get_memory_resource() == &counting);
+				copy.add_word("brand new");
+				copy.remove_word("love");
+			}
+			BOOST_TEST_CHECK(counting.outstanding == 0u);
+		}
+
+		BOOST_TEST_CONTEXT("entries copied before their counter changes are allocated by the resource")
+		{
+			{
+				dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English, &counting);
+				dictionary.add_word("love");
+
+				const auto held = dictionary.lookup("love");
+				const auto before = counting.outstanding;
+				dictionary.add_word("love");
+
+				BOOST_TEST_CHECK(dictionary.lookup("love") != held);
+				BOOST_TEST_CHECK(counting.outstanding >= before + sizeof(dictionary_creator::Entry));
+			}
+			BOOST_TEST_CHECK(counting.outstanding == 0u);
+		}
+
+		BOOST_TEST_CONTEXT("words of other resources are copied")
+		{
+			dictionary_creator::Dictionary long_lived(dictionary_creator::Language::English);
+			dictionary_creator::Dictionary same_resource(dictionary_creator::Language::English);
+			{
+				std::pmr::monotonic_buffer_resource job(&counting);
+				dictionary_creator::Dictionary partial(dictionary_creator::Language::English, &job);
+				partial.add_word("love");
+				partial.add_word("love");
+				partial.add_proper_noun("Bill");
+
+				long_lived.merge(std::move(partial));
+				BOOST_TEST_CHECK(long_lived.lookup("love") != partial.lookup("love"));
+
+				dictionary_creator::Dictionary other(dictionary_creator::Language::English);
+				other.add_word("misery");
+				auto taken = other.lookup("misery");
+				same_resource.merge(std::move(other));
+				BOOST_TEST_CHECK(same_resource.lookup("misery") == taken);
+
+				auto common = partial.intersection_with(long_lived);
+				BOOST_TEST_CHECK(common.get_memory_resource() == &job);
+			}
+			BOOST_TEST_CHECK(counting.outstanding == 0u);
+
+			BOOST_TEST_CHECK(long_lived.lookup("love")->get_counter() == 2u);
+			BOOST_TEST_CHECK(long_lived.get_proper_nouns_dictionary().at("B").size() == 1u);
+		}
+
+		BOOST_TEST_CONTEXT("memory_usage() agrees with the resource")
+		{
+			{
+				dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English, &counting);
+				for (size_t i = 0; i < 5000; ++i)
+				{
+					dictionary.add_word(u8"word" + std::to_string(i * 7919 % 100003));
+				}
+				// entries and container nodes are what the resource hands out, word strings and definitions come from the heap
+				const auto usage = dictionary.memory_usage().overall;
+				const double reported = static_cast<double>(usage.entries + usage.container_nodes);
+				const double allocated = static_cast<double>(counting.outstanding);
+				BOOST_TEST_INFO("reported " << reported << ", allocated " << allocated);
+				BOOST_TEST_CHECK(std::abs(reported - allocated) <= allocated / 100);
+			}
+			BOOST_TEST_CHECK(counting.outstanding == 0u);
+		}
+
+		BOOST_TEST_CONTEXT("bulk construction")
+		{
+			const std::vector<std::pair<std::string, size_t>> words{ { "one", 1 }, { "two", 2 } };
+			{
+				auto built = dictionary_creator::Dictionary::from_sorted(dictionary_creator::Language::English, words.begin(), words.end(), &counting);
+				BOOST_TEST_CHECK(counting.outstanding > 0u);
+			}
+			BOOST_TEST_CHECK(counting.outstanding == 0u);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(diff_and_apply)
+	{
+		using entry_state = std::tuple<size_t, bool>;
+		using entry_states = std::map<dictionary_creator::utf8_string, entry_state>;
+
+		auto states_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			entry_states result;
+			for (const auto &[letter, entries]: dictionary.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.emplace(entry->get_word(), entry_state{ entry->get_counter(), entry->is_defined() });
+				}
+			}
+			return result;
+		};
+
+		auto proper_nouns_of = [] (const dictionary_creator::Dictionary &dictionary)
+		{
+			std::set<dictionary_creator::utf8_string> result;
+			for (const auto &[letter, entries]: dictionary.get_proper_nouns_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					result.insert(entry->get_word());
+				}
+			}
+			return result;
+		};
+
+		dictionary_creator::Dictionary yesterday(dictionary_creator::Language::English);
+		for (size_t i = 0; i != 500; ++i)
+		{
+			yesterday.add_word("word" + std::to_string(i));
+		}
+		yesterday.add_word("zebra");
+		yesterday.add_word("Rome");
+		yesterday.add_proper_noun("Paris");
+		yesterday.add_proper_noun("Quebec");
+
+		BOOST_TEST_CONTEXT("copies differ in nothing")
+		{
+			const auto copy = yesterday;
+			BOOST_TEST_CHECK(yesterday.diff(copy).empty());
+			BOOST_TEST_CHECK(yesterday.diff(yesterday).empty());
+		}
+
+		auto today = yesterday;
+		today.add_word("apple");
+		today.add_word("word7");
+		today.add_word("word7");
+		today.remove_word("word11");
+		today.remove_word("zebra");
+		// entries are shared with the copy, defining one in place would define it in both
+		today.add_word<dictionary_creator::Entry>("word42");
+		today.lookup("word42")->define(fake_definer);
+		today.add_proper_noun("London");
+		today.add_word("london");
+		today.add_proper_noun("Rome");
+		today.remove_proper_nouns();
+
+		const auto delta = yesterday.diff(today);
+
+		BOOST_TEST_CONTEXT("the delta holds the changes only")
+		{
+			BOOST_TEST_CHECK(delta.empty() == false);
+			BOOST_TEST_CHECK((delta.language == dictionary_creator::Language::English));
+
+			BOOST_TEST_REQUIRE(delta.added.size() == 2u);
+			BOOST_TEST_CHECK(delta.added[0]->get_word() == "apple");
+			BOOST_TEST_CHECK(delta.added[1]->get_word() == "london");
+
+			BOOST_TEST_CHECK(std::set<dictionary_creator::utf8_string>(delta.removed.begin(), delta.removed.end())
+				== (std::set<dictionary_creator::utf8_string>{ "Rome", "word11", "zebra" }));
+
+			BOOST_TEST_REQUIRE(delta.counters.size() == 1u);
+			BOOST_TEST_CHECK(delta.counters[0].first == "word7");
+			BOOST_TEST_CHECK(delta.counters[0].second == 3u);
+
+			BOOST_TEST_REQUIRE(delta.defined.size() == 1u);
+			BOOST_TEST_CHECK(delta.defined[0]->get_word() == "word42");
+
+			BOOST_TEST_CHECK(delta.added_proper_nouns == (std::vector<dictionary_creator::utf8_string>{ "London", "Rome" }));
+			BOOST_TEST_CHECK(delta.removed_proper_nouns.empty());
+		}
+
+		BOOST_TEST_CONTEXT("applying the delta makes a replica of the newer dictionary")
+		{
+			auto replica = yesterday;
+			replica.enable_prefix_index();
+			replica.apply(delta);
+
+			BOOST_TEST_CHECK(states_of(replica) == states_of(today));
+			BOOST_TEST_CHECK(proper_nouns_of(replica) == proper_nouns_of(today));
+			BOOST_TEST_CHECK(replica.diff(today).empty());
+			BOOST_TEST_CHECK(replica.lookup("word42")->get_definitions() == today.lookup("word42")->get_definitions());
+			BOOST_TEST_CHECK(replica.get_completions("app", 5).size() == 1u);
+
+			BOOST_TEST_INFO("the replica has entries of its own");
+			BOOST_TEST_CHECK(replica.lookup("apple") != today.lookup("apple"));
+			replica.add_word("apple");
+			BOOST_TEST_CHECK(today.lookup("apple")->get_counter() == 1u);
+
+			BOOST_TEST_INFO("the other way round, dropped definitions stay");
+			auto back = today;
+			back.apply(today.diff(yesterday));
+			auto expected = states_of(yesterday);
+			expected["word42"] = entry_state{ 1, true };
+			BOOST_TEST_CHECK(states_of(back) == expected);
+			BOOST_TEST_CHECK(proper_nouns_of(back) == proper_nouns_of(yesterday));
+		}
+
+		BOOST_TEST_CONTEXT("a lower counter is set on a copy of an entry held elsewhere")
+		{
+			auto replica = today;
+			const auto held = replica.lookup("word7");
+			const auto counter = held->get_counter();
+			BOOST_TEST_REQUIRE(yesterday.lookup("word7")->get_counter() < counter);
+
+			replica.apply(today.diff(yesterday));
+			BOOST_TEST_CHECK(replica.lookup("word7")->get_counter() == yesterday.lookup("word7")->get_counter());
+			BOOST_TEST_CHECK(held->get_counter() == counter);
+			BOOST_TEST_CHECK(today.lookup("word7")->get_counter() == counter);
+		}
+
+		BOOST_CHECK_THROW(yesterday.diff(dictionary_creator::Dictionary(dictionary_creator::Language::Russian)), dictionary_creator::dictionary_runtime_error);
+		BOOST_CHECK_THROW(dictionary_creator::Dictionary(dictionary_creator::Language::Russian).apply(delta), dictionary_creator::dictionary_runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(keywords)
+	{
+		auto counted = [] (const std::vector<std::pair<dictionary_creator::utf8_string, size_t>> &words)
+		{
+			dictionary_creator::Dictionary result(dictionary_creator::Language::English);
+			for (const auto &[word, counter]: words)
+			{
+				for (size_t i = 0; i != counter; ++i)
+				{
+					result.add_word(word);
+				}
+			}
+			return result;
+		};
+
+		BOOST_TEST_CONTEXT("scores of a small table")
+		{
+			const auto author = counted({ { "cat", 10 }, { "dog", 5 } });
+			const auto reference = counted({ { "cat", 1 }, { "dog", 50 } });
+
+			const auto likelihood = author.keywords(reference, 10);
+			BOOST_TEST_REQUIRE(likelihood.size() == 1u);
+			BOOST_TEST_CHECK(likelihood.front().entry->get_word() == "cat");
+			BOOST_TEST_CHECK(likelihood.front().reference_counter == 1u);
+			BOOST_TEST_CHECK(likelihood.front().score == 2.0 * (10.0 * std::log(10.0 / 2.5) + std::log(1.0 / 8.5) + 5.0 * std::log(5.0 / 12.5) + 50.0 * std::log(50.0 / 42.5)),
+				boost::test_tools::tolerance(1e-9));
+
+			const auto chi_square = author.keywords(reference, 10, dictionary_creator::KeynessMeasure::ChiSquare);
+			BOOST_TEST_REQUIRE(chi_square.size() == 1u);
+			BOOST_TEST_CHECK(chi_square.front().score == 66.0 * 495.0 * 495.0 / (11.0 * 55.0 * 15.0 * 51.0), boost::test_tools::tolerance(1e-9));
+
+			BOOST_TEST_CHECK(reference.keywords(author, 10).front().entry->get_word() == "dog");
+		}
+
+		std::vector<std::pair<dictionary_creator::utf8_string, size_t>> author_words;
+		std::vector<std::pair<dictionary_creator::utf8_string, size_t>> reference_words;
+		for (size_t i = 0; i != 400; ++i)
+		{
+			const auto word = "word" + std::to_string(i);
+			if (i < 300)
+			{
+				author_words.emplace_back(word, i % 7 + 1);
+			}
+			if (i >= 150)
+			{
+				reference_words.emplace_back(word, (i % 5 + 1) * 3);
+			}
+		}
+
+		const auto author = counted(author_words);
+		const auto reference = counted(reference_words);
+
+		for (auto measure: { dictionary_creator::KeynessMeasure::LogLikelihood, dictionary_creator::KeynessMeasure::ChiSquare })
+		{
+			// looked up word by word and sorted as a whole
+			std::vector<std::pair<double, dictionary_creator::utf8_string>> expected;
+			double own_total = 0.0;
+			for (const auto &[word, counter]: author_words)
+			{
+				own_total += static_cast<double>(counter);
+			}
+			double theirs_total = 0.0;
+			for (const auto &[word, counter]: reference_words)
+			{
+				theirs_total += static_cast<double>(counter);
+			}
+
+			for (const auto &[letter, entries]: author.get_main_dictionary())
+			{
+				for (const auto &entry: entries)
+				{
+					const auto found = reference.lookup(entry->get_word());
+					const double a = static_cast<double>(entry->get_counter());
+					const double b = found ? static_cast<double>(found->get_counter()) : 0.0;
+
+					if (a / own_total <= b / theirs_total)
+					{
+						continue;
+					}
+
+					const double total = own_total + theirs_total;
+					double score = 0.0;
+					if (measure == dictionary_creator::KeynessMeasure::LogLikelihood)
+					{
+						auto cell = [total] (double observed, double expected) { return observed > 0.0 ? observed * std::log(observed / expected) : 0.0; };
+						const double rest = total - a - b;
+
+						score = 2.0 * (cell(a, own_total * (a + b) / total) + cell(b, theirs_total * (a + b) / total)
+							+ cell(own_total - a, own_total * rest / total) + cell(theirs_total - b, theirs_total * rest / total));
+					}
+					else
+					{
+						const double cross = a * (theirs_total - b) - b * (own_total - a);
+						score = total * cross * cross / ((a + b) * (total - a - b) * own_total * theirs_total);
+					}
+
+					expected.emplace_back(score, entry->get_word());
+				}
+			}
+
+			std::stable_sort(expected.begin(), expected.end(), [] (const auto &x, const auto &y) { return x.first > y.first; });
+
+			for (size_t quantity: { size_t{ 0 }, size_t{ 1 }, size_t{ 17 }, expected.size(), size_t{ 1000 } })
+			{
+				BOOST_TEST_CONTEXT("measure " << static_cast<size_t>(measure) << ", quantity " << quantity)
+				{
+					const auto found = author.keywords(reference, quantity, measure);
+					BOOST_TEST_REQUIRE(found.size() == std::min(quantity, expected.size()));
+
+					for (size_t i = 0; i != found.size(); ++i)
+					{
+						BOOST_TEST_INFO(expected[i].second);
+						BOOST_TEST_CHECK(found[i].entry->get_word() == expected[i].second);
+						BOOST_TEST_CHECK(found[i].score == expected[i].first, boost::test_tools::tolerance(1e-9));
+					}
+				}
+			}
+		}
+
+		BOOST_TEST_INFO("nothing stands out against itself");
+		BOOST_TEST_CHECK(author.keywords(author, 10).empty());
+
+		BOOST_TEST_CONTEXT("an empty reference or an empty dictionary yield no keywords")
+		{
+			const dictionary_creator::Dictionary empty(dictionary_creator::Language::English);
+			BOOST_TEST_CHECK(author.keywords(empty, 10).empty());
+			BOOST_TEST_CHECK(author.keywords(empty, 10, dictionary_creator::KeynessMeasure::ChiSquare).empty());
+			BOOST_TEST_CHECK(empty.keywords(author, 10).empty());
+		}
+
+		BOOST_CHECK_THROW(author.keywords(dictionary_creator::Dictionary(dictionary_creator::Language::Russian), 10), dictionary_creator::dictionary_runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(top_through_heap)
+	{
+		// large enough for the pool to take letters apart, counters and lengths repeat a lot
+		dictionary_creator::Dictionary eng(dictionary_creator::Language::English);
+		for (size_t i = 0; i != 34'000; ++i)
+		{
+			const auto word = dictionary_creator::utf8_string(1, static_cast<char>('a' + i % 26)) + std::to_string(i * 7919 % 100'003);
+			for (size_t repeat = 0; repeat != i % 3 + 1; ++repeat)
+			{
+				eng.add_word(word);
+			}
+		}
+
+		dictionary_creator::subset_t all;
+		for (const auto &[letter, entries]: eng.get_main_dictionary())
+		{
+			all.insert(all.end(), entries.begin(), entries.end());
+		}
+
+		dictionary_creator::ThreadPool pool(4);
+
+		for (size_t criterion = 0; criterion != dictionary_creator::criteria_dependent_sorters.size(); ++criterion)
+		{
+			auto expected = all;
+			std::stable_sort(expected.begin(), expected.end(), dictionary_creator::criteria_dependent_sorters[criterion]);
+
+			for (size_t quantity: { size_t{ 0 }, size_t{ 1 }, size_t{ 20 }, size_t{ 500 } })
+			{
+				BOOST_TEST_CONTEXT("criterion " << criterion << ", quantity " << quantity)
+				{
+					const auto type = static_cast<dictionary_creator::ComparisonType>(criterion);
+					const auto top = eng.get_top(type, quantity);
+					const auto parallel_top = eng.get_top(type, quantity, pool);
+
+					BOOST_TEST_REQUIRE(top.size() == std::min(quantity, all.size()));
+					BOOST_TEST_CHECK(std::equal(top.begin(), top.end(), expected.begin()));
+					BOOST_TEST_CHECK((parallel_top == top));
+				}
+			}
+		}
+
+		dictionary_creator::Dictionary small(dictionary_creator::Language::English);
+		small.add_word("one");
+		small.add_word("two");
+		small.add_word("two");
+		BOOST_TEST_CHECK((small.get_top(dictionary_creator::ComparisonType::MostFrequent, 5, pool) == small.get_top(dictionary_creator::ComparisonType::MostFrequent, 5)));
+		BOOST_TEST_CHECK(dictionary_creator::Dictionary(dictionary_creator::Language::English).get_top(dictionary_creator::ComparisonType::Longest, 5, pool).empty());
+	}
+
+	BOOST_AUTO_TEST_CASE(entry_handles)
+	{
+		dictionary_creator::Dictionary eng(dictionary_creator::Language::English);
+		eng.add_word("love");
+		eng.add_word("misery");
+
+		BOOST_TEST_CONTEXT("handles are snapshots of the counter")
+		{
+			const auto held = eng.lookup("love");
+			eng.add_word("love");
+
+			BOOST_TEST_CHECK(held->get_counter() == 1u);
+			BOOST_TEST_CHECK(eng.lookup("love")->get_counter() == 2u);
+			BOOST_TEST_CHECK(eng.lookup("love") != held);
+		}
+
+		BOOST_TEST_CONTEXT("an entry nobody else holds is changed in place")
+		{
+			const auto *before = eng.lookup("love").get();
+			eng.add_word("love");
+			BOOST_TEST_CHECK(eng.lookup("love").get() == before);
+			BOOST_TEST_CHECK(eng.lookup("love")->get_counter() == 3u);
+		}
+
+		BOOST_TEST_CONTEXT("copies don't see counters of each other")
+		{
+			auto copy = eng;
+			copy.add_word("misery");
+
+			BOOST_TEST_CHECK(eng.lookup("misery")->get_counter() == 1u);
+			BOOST_TEST_CHECK(copy.lookup("misery")->get_counter() == 2u);
+		}
+
+		BOOST_TEST_CONTEXT("define() reaches everything sharing the entry")
+		{
+			auto copy = eng;
+			const auto held = eng.lookup("love");
+
+			held->define([] (const dictionary_creator::utf8_string &)
+				{
+					return dictionary_creator::definitions_t{ { "verb", { "feel deep affection" } } };
+				});
+
+			BOOST_TEST_CHECK(eng.lookup("love")->is_defined());
+			BOOST_TEST_CHECK(copy.lookup("love")->is_defined());
+		}
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
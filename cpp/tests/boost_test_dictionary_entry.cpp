@@ -3,6 +3,8 @@
 
 #include "dictionary_entry.h"
 
+#include <filesystem>
+
 BOOST_AUTO_TEST_SUITE(dictionary_entry)
 
 	BOOST_AUTO_TEST_CASE(dictionary_entry_alltogether)
@@ -21,6 +23,21 @@ BOOST_AUTO_TEST_SUITE(dictionary_entry)
 		BOOST_TEST_INFO("get_word()");
 		BOOST_TEST_CHECK(entry.get_word() == word);
 
+		BOOST_TEST_CONTEXT("get_sort_key()")
+		{
+			BOOST_TEST_CHECK(entry.get_sort_key() == word);
+			BOOST_TEST_CHECK(dictionary_creator::Entry(u8"école").get_sort_key() < dictionary_creator::Entry(u8"écran").get_sort_key());
+			BOOST_TEST_CHECK(dictionary_creator::Entry(u8"écran").get_sort_key() < dictionary_creator::Entry(u8"zèbre").get_sort_key());
+		}
+
+		BOOST_TEST_CONTEXT("get_length()")
+		{
+			BOOST_TEST_CHECK(entry.get_length() == word.size());
+			BOOST_TEST_CHECK(dictionary_creator::Entry(u8"école").get_length() == 5u);
+			BOOST_TEST_CHECK(dictionary_creator::Entry(u8"ёжик").get_length() == 4u);
+			BOOST_TEST_CHECK(dictionary_creator::Entry(*dictionary_creator::Entry(u8"zèbre").clone()).get_length() == 5u);
+		}
+
 		BOOST_TEST_CONTEXT("counter - get_counter() and increment counter()")
 		{
 			BOOST_TEST_CHECK(entry.get_counter() == 1U);
@@ -30,6 +47,16 @@ BOOST_AUTO_TEST_SUITE(dictionary_entry)
 			BOOST_TEST_CHECK(entry.get_counter() == 1'000'002U);
 		}
 
+		BOOST_TEST_CONTEXT("set_counter()")
+		{
+			auto counted = entry;
+			counted.set_counter(7);
+			BOOST_TEST_CHECK(counted.get_counter() == 7U);
+			counted.set_counter(1);
+			BOOST_TEST_CHECK(counted.get_counter() == 1U);
+			BOOST_TEST_CHECK(entry.get_counter() == 1'000'002U);
+		}
+
 		BOOST_TEST_CONTEXT("define(definer_t)")
 		{
 			BOOST_TEST_CHECK(entry.is_defined() == false);
@@ -55,10 +82,88 @@ BOOST_AUTO_TEST_SUITE(dictionary_entry)
 			BOOST_TEST_CHECK(define_res == entry);
 			BOOST_TEST_CHECK(entry.get_definitions() == definitions);
 		}
+
+		BOOST_TEST_CONTEXT("get_compact_definitions()")
+		{
+			const auto &compact = entry.get_compact_definitions();
+			BOOST_TEST_CHECK(compact.size() == 6u);
+			BOOST_TEST_CHECK(compact.memory_usage() == 6u * sizeof(dictionary_creator::Definition));
+
+			BOOST_TEST_INFO("pairs follow the order of definitions_t");
+			BOOST_TEST_CHECK(dictionary_creator::CompactDefinitions::text(compact.begin()->part_of_speech) == "A");
+			BOOST_TEST_CHECK(dictionary_creator::CompactDefinitions::text(compact.begin()->meaning) == "B");
+			BOOST_TEST_CHECK(dictionary_creator::CompactDefinitions::text((compact.end() - 1)->part_of_speech) == "One");
+			BOOST_TEST_CHECK(dictionary_creator::CompactDefinitions::text((compact.end() - 1)->meaning) == "Two");
+
+			BOOST_TEST_INFO("equal strings are pooled once");
+			auto pooled_before = dictionary_creator::StringPool::shared().size();
+			dictionary_creator::Entry synonym("antidisestablishmentarianism");
+			synonym.define([] (auto) { return dictionary_creator::definitions_t{ { "One", { "Two", "Three" } } }; });
+			BOOST_TEST_CHECK(dictionary_creator::StringPool::shared().size() == pooled_before);
+			BOOST_TEST_CHECK(synonym.get_compact_definitions().begin()->part_of_speech == (compact.end() - 1)->part_of_speech);
+
+			BOOST_TEST_INFO("copies are independent");
+			auto copy = compact;
+			BOOST_TEST_CHECK(copy.expand() == compact.expand());
+			BOOST_TEST_CHECK(copy.begin() != compact.begin());
+
+			BOOST_TEST_CHECK(dictionary_creator::CompactDefinitions{}.expand().empty());
+
+			BOOST_TEST_INFO("parts of speech without meanings are kept");
+			const dictionary_creator::definitions_t bare{ { "noun", {} }, { "verb", { "run" } }, { "adverb", {} } };
+			const dictionary_creator::CompactDefinitions kept(bare);
+			BOOST_TEST_CHECK(kept.expand() == bare);
+			BOOST_TEST_CHECK(kept.size() == 3u);
+			BOOST_TEST_CHECK(kept.count_meanings() == 1u);
+		}
+
+		BOOST_TEST_CONTEXT("defined by parts of speech without meanings")
+		{
+			const dictionary_creator::definitions_t bare{ { "noun", {} } };
+
+			dictionary_creator::Entry undescribed("thingamajig");
+			undescribed.define([&bare] (auto) { return bare; });
+
+			BOOST_TEST_CHECK(undescribed.is_defined());
+			BOOST_TEST_CHECK(undescribed.get_definitions() == bare);
+			BOOST_TEST_CHECK(undescribed.count_definitions() == 0u);
+			BOOST_TEST_CHECK(undescribed.clone()->get_definitions() == bare);
+
+			dictionary_creator::Entry undefined("nothing");
+			undefined.define([] (auto) { return dictionary_creator::definitions_t{}; });
+			BOOST_TEST_CHECK(undefined.is_defined() == false);
+		}
 		
 		BOOST_TEST_INFO("operator const char *()");
 		BOOST_TEST_CHECK(static_cast<const char *>(entry) == word.data());
 
+		BOOST_TEST_CONTEXT("clone()")
+		{
+			auto copy = entry.clone();
+			BOOST_TEST_REQUIRE(copy != nullptr);
+			BOOST_TEST_CHECK(copy->get_word() == word);
+			BOOST_TEST_CHECK(copy->get_counter() == entry.get_counter());
+			BOOST_TEST_CHECK(copy->get_definitions() == entry.get_definitions());
+
+			copy->increment_counter();
+			BOOST_TEST_CHECK(copy->get_counter() == entry.get_counter() + 1);
+
+			struct DerivedEntry : dictionary_creator::Entry
+			{
+				using dictionary_creator::Entry::Entry;
+			};
+
+			BOOST_TEST_INFO("derived entries aren't sliced");
+			BOOST_TEST_CHECK(DerivedEntry(word).clone() == nullptr);
+		}
+
+		BOOST_TEST_CONTEXT("count_definitions()")
+		{
+			BOOST_TEST_CHECK(entry.count_definitions() == entry.get_compact_definitions().size());
+			BOOST_TEST_CHECK(entry.has_definitions_apart() == false);
+			BOOST_TEST_CHECK(dictionary_creator::Entry{}.count_definitions() == 0u);
+		}
+
 		BOOST_TEST_CONTEXT("Default uninitialized object")
 		{
 			dictionary_creator::Entry empty_entry;
@@ -66,4 +171,67 @@ BOOST_AUTO_TEST_SUITE(dictionary_entry)
 		}
 	}
 
+	BOOST_AUTO_TEST_CASE(definitions_section)
+	{
+		const auto file = std::filesystem::temp_directory_path() / "dictionary_entry_regress_test.dfn";
+		const dictionary_creator::definitions_t first{ { "noun", { "a fruit", "a company" } }, { "adjective", { "red" } } };
+		const dictionary_creator::definitions_t second{ { "verb", { u8"сказать" } } };
+		const dictionary_creator::definitions_t third{ { "", { "" } } };
+
+		std::vector<dictionary_creator::DefinitionsSection::record_type> records;
+
+		BOOST_TEST_CONTEXT("writing")
+		{
+			auto section = dictionary_creator::DefinitionsSection::create(file);
+			for (const auto &definitions: { first, second, third, dictionary_creator::definitions_t{} })
+			{
+				records.push_back(section->append(definitions));
+			}
+			section->finish();
+
+			BOOST_TEST_CHECK(std::is_sorted(records.begin(), records.end()));
+			BOOST_CHECK_THROW(section->read(records.front()), dictionary_creator::dictionary_runtime_error);
+		}
+
+		BOOST_TEST_CONTEXT("reading in any order")
+		{
+			auto section = dictionary_creator::DefinitionsSection::open(file);
+			BOOST_TEST_CHECK(section->resident() == 0u);
+
+			BOOST_TEST_CHECK(section->read(records[2]) == third);
+			BOOST_TEST_CHECK(section->read(records[0]) == first);
+			BOOST_TEST_CHECK(section->read(records[3]).empty());
+			BOOST_TEST_CHECK(section->read(records[1]) == second);
+			BOOST_TEST_CHECK(section->read(records[0]) == first);
+			BOOST_TEST_CHECK(section->resident() == 4u);
+
+			BOOST_CHECK_THROW(section->append(first), dictionary_creator::dictionary_runtime_error);
+		}
+
+		BOOST_TEST_CONTEXT("resident limit")
+		{
+			auto section = dictionary_creator::DefinitionsSection::open(file, 2);
+			for (auto record: records)
+			{
+				section->read(record);
+				BOOST_TEST_CHECK(section->resident() <= 2u);
+			}
+			BOOST_TEST_CHECK(section->read(records[0]) == first);
+			BOOST_TEST_CHECK(section->read(records[1]) == second);
+			BOOST_TEST_CHECK(section->resident() == 2u);
+
+			BOOST_TEST_INFO("the definitions just read are kept at least");
+			auto single = dictionary_creator::DefinitionsSection::open(file, 0);
+			BOOST_TEST_CHECK(single->read(records[1]) == second);
+			BOOST_TEST_CHECK(single->resident() == 1u);
+		}
+
+		BOOST_TEST_CONTEXT("not a section")
+		{
+			BOOST_CHECK_THROW(dictionary_creator::DefinitionsSection::open(file.string() + ".missing"), dictionary_creator::dictionary_runtime_error);
+		}
+
+		std::filesystem::remove(file);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,9 +10,15 @@
 
 #include "dictionary_manager.h"
 
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+
 #include <array>
 #include <algorithm>
 #include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
 
 #include <iostream>
 
@@ -249,6 +255,42 @@ bool has_word(const dictionary_creator::subset_t &subset, dictionary_creator::ut
 	return std::find_if(subset.begin(), subset.end(), [&word] (auto x) { return x->get_word() == word; }) != subset.end();
 }
 
+bool longer_word(const dictionary_creator::Entry &a, const dictionary_creator::Entry &b)
+{
+	return a.get_length() > b.get_length();
+}
+
+BOOST_FIXTURE_TEST_CASE(subset_by_callable, DictionaryManagerObjects)
+{
+	BOOST_TEST_CONTEXT("a lambda")
+	{
+		auto by_lambda = eng.get_subset([] (const dictionary_creator::Entry &a, const dictionary_creator::Entry &b)
+			{
+				return a.get_length() > b.get_length();
+			}, 1);
+		BOOST_TEST_REQUIRE(by_lambda.size() == 1u);
+		BOOST_TEST_CHECK(by_lambda.front()->get_word() == "xeroradiography");
+	}
+
+	BOOST_TEST_CONTEXT("a move-only callable, which no std::function could hold")
+	{
+		auto calls = std::make_unique<size_t>(0);
+		auto by_move_only = eng.get_subset([calls = std::move(calls)] (const dictionary_creator::Entry &a, const dictionary_creator::Entry &b)
+			{
+				++*calls;
+				return a.get_length() < b.get_length();
+			}, 4);
+		BOOST_TEST_CHECK(by_move_only.size() == 4u);
+		BOOST_TEST_CHECK(has_word(by_move_only, "cat"));
+	}
+
+	BOOST_TEST_CONTEXT("a function and a std::function")
+	{
+		BOOST_TEST_CHECK(eng.get_subset(longer_word, 1).front()->get_word() == "xeroradiography");
+		BOOST_TEST_CHECK(eng.get_subset(dictionary_creator::less_comp_t<dictionary_creator::Entry>(longer_word), 1).front()->get_word() == "xeroradiography");
+	}
+}
+
 BOOST_FIXTURE_TEST_CASE(subset_features, DictionaryManagerObjects)
 {
 	BOOST_TEST_CONTEXT("first letter")
@@ -651,6 +693,7 @@ struct serialization_cleaner
 		std::filesystem::path file = std::string{ directoryname } + "/" + filename + ".dic";
 
 		BOOST_TEST_CHECK(std::filesystem::remove(file));
+		BOOST_TEST_CHECK(std::filesystem::remove(file.replace_extension(".skt")));
 		BOOST_TEST_CHECK(std::filesystem::remove(directoryname));
 	}
 
@@ -712,3 +755,177 @@ BOOST_FIXTURE_TEST_CASE(serializing, serialization_cleaner)
 		loaded.save_dictionary();
 	}
 }
+
+BOOST_FIXTURE_TEST_CASE(definitions_apart, serialization_cleaner)
+{
+	const std::filesystem::path definitions_file = directoryname + "/" + filename + ".dfn";
+	const dictionary_creator::definitions_t apple{ { "noun", { "a fruit", "a company" } } };
+
+	BOOST_TEST_CONTEXT("saving definitions apart")
+	{
+		dictionary_creator::DictionaryManager manager(dictionary_creator::Language::English, filename);
+		manager.lookup_or_add_word("apple")->define([&apple] (auto) { return apple; });
+		manager.lookup_or_add_word("banana")->define([] (auto) { return dictionary_creator::definitions_t{ { "noun", { "a fruit" } } }; });
+		manager.lookup_or_add_word("cherry");
+
+		manager.save_dictionary(dictionary_creator::DefinitionsStorage::Apart);
+		BOOST_TEST_CHECK(std::filesystem::exists(definitions_file));
+		BOOST_TEST_CHECK(dictionary_creator::available_dictionaries().size() == 1u);
+	}
+
+	BOOST_TEST_CONTEXT("loading reads definitions on demand")
+	{
+		auto loaded = dictionary_creator::load_dictionary(directoryname + "/" + filename + ".dic", 1);
+
+		auto entry = loaded.lookup_or_add_word("apple");
+		BOOST_TEST_CHECK(entry->is_defined());
+		BOOST_TEST_CHECK(entry->has_definitions_apart());
+		BOOST_TEST_CHECK(entry->count_definitions() == 2u);
+		BOOST_TEST_CHECK(entry->get_compact_definitions().empty());
+		BOOST_TEST_CHECK(entry->get_definitions() == apple);
+		BOOST_TEST_CHECK(loaded.lookup_or_add_word("banana")->get_definitions().size() == 1u);
+		BOOST_TEST_CHECK(entry->get_definitions() == apple);
+		BOOST_TEST_CHECK(loaded.get_undefined().size() == 1u);
+
+		BOOST_TEST_INFO("saving again, over the section being read");
+		loaded.save_dictionary(dictionary_creator::DefinitionsStorage::Apart);
+		BOOST_TEST_CHECK(entry->get_definitions() == apple);
+
+		BOOST_TEST_INFO("a word defined before the others moves their records, the entries loaded follow them");
+		loaded.lookup_or_add_word("aardvark")->define([] (auto) { return dictionary_creator::definitions_t{ { "noun", { "an animal", "a burrower" } } }; });
+		loaded.save_dictionary(dictionary_creator::DefinitionsStorage::Apart);
+		BOOST_TEST_CHECK(loaded.lookup_or_add_word("banana")->get_definitions().size() == 1u);
+		BOOST_TEST_CHECK(entry->get_definitions() == apple);
+		BOOST_TEST_CHECK(dictionary_creator::load_dictionary(directoryname + "/" + filename + ".dic").lookup_or_add_word("apple")->get_definitions() == apple);
+	}
+
+	BOOST_TEST_CONTEXT("saving inline drops the section")
+	{
+		auto loaded = dictionary_creator::load_dictionary(directoryname + "/" + filename + ".dic");
+		BOOST_TEST_CHECK(loaded.lookup_or_add_word("apple")->get_definitions() == apple);
+
+		loaded.save_dictionary();
+		BOOST_TEST_CHECK(!std::filesystem::exists(definitions_file));
+
+		auto reloaded = dictionary_creator::load_dictionary(directoryname + "/" + filename + ".dic");
+		BOOST_TEST_CHECK(reloaded.lookup_or_add_word("apple")->has_definitions_apart() == false);
+		BOOST_TEST_CHECK(reloaded.lookup_or_add_word("apple")->get_definitions() == apple);
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(word_sketches, serialization_cleaner)
+{
+	const auto dictionary_file = directoryname + "/" + filename + ".dic";
+
+	BOOST_TEST_CONTEXT("missing sketch")
+	{
+		BOOST_CHECK_THROW(dictionary_creator::load_word_sketch(dictionary_file), std::runtime_error);
+	}
+
+	dictionary_creator::DictionaryManager manager(dictionary_creator::Language::English, filename);
+	for (const auto &word: { "apple", "banana", "cherry", "date" })
+	{
+		manager.lookup_or_add_word(word);
+	}
+
+	BOOST_TEST_CONTEXT("a sketch that can't be written fails the saving")
+	{
+		const auto sketch_file = std::filesystem::path(dictionary_file).replace_extension(".skt");
+		std::filesystem::create_directories(sketch_file);
+
+		BOOST_CHECK_THROW(manager.save_dictionary(), std::runtime_error);
+		BOOST_TEST_CHECK(std::filesystem::remove(sketch_file));
+	}
+
+	BOOST_TEST_CONTEXT("saving writes the sketch next to the dictionary")
+	{
+		manager.save_dictionary();
+
+		const auto sketch = dictionary_creator::load_word_sketch(dictionary_file);
+		BOOST_TEST_CHECK(sketch.estimated_words() == 4.0);
+		BOOST_TEST_CHECK(sketch.jaccard(manager.get_word_sketch()) == 1.0);
+	}
+
+	BOOST_TEST_CONTEXT("the saved sketch follows the dictionary")
+	{
+		manager.lookup_or_add_word("elderberry");
+		manager.save_dictionary();
+
+		dictionary_creator::DictionaryManager fruits(dictionary_creator::Language::English);
+		for (const auto &word: { "apple", "banana", "fig" })
+		{
+			fruits.lookup_or_add_word(word);
+		}
+
+		const auto sketch = dictionary_creator::load_word_sketch(dictionary_file);
+		BOOST_TEST_CHECK(sketch.estimated_words() == 5.0);
+		BOOST_TEST_CHECK(sketch.intersection_size(fruits.get_word_sketch()) == 2.0);
+		BOOST_TEST_CHECK(sketch.jaccard(fruits.get_word_sketch()) == 2.0 / 6.0);
+	}
+}
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+	size_t outstanding = 0;
+
+private:
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		outstanding += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void *pointer, size_t bytes, size_t alignment) override
+	{
+		outstanding -= bytes;
+		std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+BOOST_AUTO_TEST_CASE(loading_keeps_memory_resource)
+{
+	dictionary_creator::Dictionary saved(dictionary_creator::Language::English);
+	for (const auto &word: { "apple", "banana", "banana", "cherry" })
+	{
+		saved.add_word(word);
+	}
+	saved.add_proper_noun("Bill");
+
+	std::stringstream stream;
+	{
+		boost::archive::text_oarchive oa(stream);
+		oa & saved;
+	}
+
+	CountingResource counting;
+	{
+		dictionary_creator::Dictionary loaded(dictionary_creator::Language::English, &counting);
+		{
+			boost::archive::text_iarchive ia(stream);
+			ia & loaded;
+		}
+
+		BOOST_TEST_CHECK(loaded.total_words() == 3u);
+		BOOST_TEST_CHECK(loaded.lookup("banana")->get_counter() == 2u);
+		BOOST_TEST_CHECK(loaded.get_memory_resource() == &counting);
+
+		for (const auto *letters: { &loaded.get_main_dictionary(), &loaded.get_proper_nouns_dictionary() })
+		{
+			for (const auto &[letter, entries]: *letters)
+			{
+				BOOST_TEST_INFO(letter);
+				BOOST_TEST_CHECK(entries.get_resource() == &counting);
+			}
+		}
+
+		BOOST_TEST_INFO("entries are allocated by the resource too");
+		BOOST_TEST_CHECK(counting.outstanding >= 4 * sizeof(dictionary_creator::Entry));
+	}
+	BOOST_TEST_CHECK(counting.outstanding == 0u);
+}
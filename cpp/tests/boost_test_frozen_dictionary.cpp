@@ -0,0 +1,108 @@
+#define BOOST_TEST_MODULE Frozen Dictionary Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "frozen_dictionary.h"
+
+BOOST_AUTO_TEST_SUITE(frozen_dictionary_alltogether)
+
+	const std::initializer_list<dictionary_creator::utf8_string> russian_words
+	{
+		u8"атлет", u8"броня", u8"волк", u8"глава", u8"день", u8"если", u8"ёжик", u8"жесть", u8"зонтик",
+		u8"истина", u8"йогурт", u8"каватина", u8"лучше", u8"метрополитен", u8"низина", u8"оружие"
+	};
+
+	BOOST_AUTO_TEST_CASE(empty_dictionary)
+	{
+		dictionary_creator::Dictionary empty(dictionary_creator::Language::English);
+		auto frozen = empty.freeze();
+
+		BOOST_TEST_CHECK(frozen.total_words() == 0u);
+		BOOST_TEST_CHECK(frozen.contains_word("anything") == false);
+		BOOST_TEST_CHECK(frozen.lookup("anything") == nullptr);
+		BOOST_TEST_CHECK(frozen.get_counter("anything") == 0u);
+		BOOST_TEST_CHECK((frozen.get_language() == dictionary_creator::Language::English));
+	}
+
+	BOOST_AUTO_TEST_CASE(lookups_match_origin)
+	{
+		dictionary_creator::Dictionary rus(dictionary_creator::Language::Russian);
+		for (const auto &word: russian_words)
+		{
+			rus.add_word(word);
+		}
+		rus.add_word(u8"волк");
+		rus.add_word(u8"волк");
+
+		auto frozen = rus.freeze();
+
+		BOOST_TEST_CHECK(frozen.total_words() == russian_words.size());
+
+		for (const auto &word: russian_words)
+		{
+			BOOST_TEST_INFO(word);
+			BOOST_TEST_CHECK(frozen.contains_word(word));
+			BOOST_TEST_CHECK(frozen.lookup(word) == rus.lookup(word).get());
+			BOOST_TEST_CHECK(frozen.get_counter(word) == rus.lookup(word)->get_counter());
+		}
+
+		BOOST_TEST_CHECK(frozen.get_counter(u8"волк") == 3u);
+
+		BOOST_TEST_INFO("misses include prefixes, extensions and empty string");
+		BOOST_TEST_CHECK(frozen.contains_word(u8"вол") == false);
+		BOOST_TEST_CHECK(frozen.contains_word(u8"волки") == false);
+		BOOST_TEST_CHECK(frozen.contains_word("") == false);
+		BOOST_TEST_CHECK(frozen.lookup("wolf") == nullptr);
+	}
+
+	BOOST_AUTO_TEST_CASE(snapshot_is_immutable)
+	{
+		dictionary_creator::Dictionary eng(dictionary_creator::Language::English);
+		eng.add_word("stable");
+
+		auto frozen = eng.freeze();
+
+		eng.add_word("stable");
+		eng.add_word("later");
+
+		BOOST_TEST_CHECK(frozen.get_counter("stable") == 1u);
+		BOOST_TEST_CHECK(frozen.contains_word("later") == false);
+	}
+
+	BOOST_AUTO_TEST_CASE(many_words)
+	{
+		dictionary_creator::Dictionary eng(dictionary_creator::Language::English);
+
+		dictionary_creator::utf8_string word = "aaaa";
+		for (size_t i = 0; i != 20'000; ++i)
+		{
+			for (size_t position = word.size(); position-- != 0; )
+			{
+				if (++word[position] <= 'z')
+				{
+					break;
+				}
+				word[position] = 'a';
+			}
+			eng.add_word(word);
+		}
+
+		auto frozen = eng.freeze();
+		BOOST_TEST_REQUIRE(frozen.total_words() == eng.total_words());
+
+		bool all_found = true;
+		for (const auto &[letter, entries]: eng.get_main_dictionary())
+		{
+			for (const auto &entry: entries)
+			{
+				all_found = all_found && frozen.lookup(entry->get_word()) == entry.get();
+			}
+		}
+		BOOST_TEST_CHECK(all_found);
+
+		BOOST_TEST_CHECK(frozen.contains_word("zzzz") == false);
+		BOOST_TEST_CHECK(frozen.contains_word("aaaa") == false);
+		BOOST_TEST_CHECK(frozen.contains_word("aaab"));
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+#define BOOST_TEST_MODULE Fuzzy Index Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "fuzzy_index.h"
+#include "dictionary_examples.h"
+
+BOOST_AUTO_TEST_SUITE(fuzzy_index_alltogether)
+
+	using d_ex::words_of;
+	using d_ex::make_entry;
+
+	BOOST_AUTO_TEST_CASE(edit_distance)
+	{
+		using dictionary_creator::edit_distance;
+
+		BOOST_TEST_CHECK(edit_distance("", "") == 0u);
+		BOOST_TEST_CHECK(edit_distance("word", "") == 4u);
+		BOOST_TEST_CHECK(edit_distance("kitten", "sitting") == 3u);
+		BOOST_TEST_CHECK(edit_distance("flaw", "lawn") == 2u);
+		BOOST_TEST_CHECK(edit_distance("receive", "recieve") == 2u);
+
+		BOOST_TEST_INFO("multibyte letters count as one edit");
+		BOOST_TEST_CHECK(edit_distance(u8"école", u8"ecole") == 1u);
+		BOOST_TEST_CHECK(edit_distance(u8"ёлка", u8"елка") == 1u);
+		BOOST_TEST_CHECK(edit_distance(u8"ёлка", u8"лка") == 1u);
+	}
+
+	BOOST_AUTO_TEST_CASE(index_on_its_own)
+	{
+		using words = std::vector<dictionary_creator::utf8_string>;
+
+		dictionary_creator::FuzzyIndex index(2);
+
+		BOOST_TEST_CHECK(index.suggest("word", 10, 2).empty());
+
+		index.insert(make_entry("word", 5));
+		index.insert(make_entry("ward", 9));
+		index.insert(make_entry("world", 3));
+		index.insert(make_entry("sword", 3));
+		index.insert(make_entry("banana", 100));
+
+		BOOST_TEST_CHECK(index.total_words() == 5u);
+		BOOST_TEST_CHECK(index.get_max_distance() == 2u);
+
+		BOOST_TEST_CHECK(words_of(index.suggest("word", 10, 2)) == (words{ "ward", "word", "sword", "world" }));
+		BOOST_TEST_CHECK(words_of(index.suggest("word", 10, 0)) == (words{ "word" }));
+		BOOST_TEST_CHECK(words_of(index.suggest("wrd", 2, 1)) == (words{ "ward", "word" }));
+		BOOST_TEST_CHECK(words_of(index.suggest("bananas", 10, 5)) == (words{ "banana" }));
+		BOOST_TEST_CHECK(index.suggest("word", 0, 2).empty());
+
+		BOOST_TEST_CONTEXT("insert() of a known word refreshes its entry")
+		{
+			index.insert(make_entry("word", 50));
+			BOOST_TEST_CHECK(index.total_words() == 5u);
+			BOOST_TEST_CHECK(words_of(index.suggest("wrd", 1, 1)) == (words{ "word" }));
+		}
+
+		BOOST_TEST_CONTEXT("erase()")
+		{
+			index.erase("word");
+			index.erase("absent");
+			BOOST_TEST_CHECK(index.total_words() == 4u);
+			BOOST_TEST_CHECK(words_of(index.suggest("word", 10, 1)) == (words{ "ward", "sword", "world" }));
+
+			index.insert(make_entry("wordy", 1));
+			BOOST_TEST_CHECK(words_of(index.suggest("word", 10, 1)) == (words{ "ward", "sword", "world", "wordy" }));
+		}
+
+		BOOST_TEST_CONTEXT("clear()")
+		{
+			index.clear();
+			BOOST_TEST_CHECK(index.total_words() == 0u);
+			BOOST_TEST_CHECK(index.suggest("word", 10, 2).empty());
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(dictionary_suggestions)
+	{
+		using words = std::vector<dictionary_creator::utf8_string>;
+
+		dictionary_creator::Dictionary indexed(dictionary_creator::Language::French);
+		dictionary_creator::Dictionary scanned(dictionary_creator::Language::French);
+
+		indexed.enable_fuzzy_index(1);
+		BOOST_TEST_CHECK(indexed.has_fuzzy_index());
+		BOOST_TEST_CHECK(scanned.has_fuzzy_index() == false);
+
+		for (auto word: { u8"école", u8"école", u8"écale", u8"colle", u8"colle", u8"colle", u8"étoile" })
+		{
+			indexed.add_word(word);
+			scanned.add_word(word);
+		}
+
+		for (auto *dictionary: { &indexed, &scanned })
+		{
+			BOOST_TEST_CHECK(words_of(dictionary->get_suggestions(u8"ecole", 10, 1)) == (words{ u8"école" }));
+			BOOST_TEST_CHECK(words_of(dictionary->get_suggestions(u8"écolle", 10, 1)) == (words{ u8"colle", u8"école" }));
+			BOOST_TEST_CHECK(words_of(dictionary->get_suggestions(u8"ecole", 10, 2)) == (words{ u8"colle", u8"école", u8"écale" }));
+			BOOST_TEST_CHECK(dictionary->get_suggestions(u8"zzz", 10).empty());
+		}
+
+		BOOST_TEST_CONTEXT("index follows add_word() and remove_word()")
+		{
+			indexed.remove_word(u8"école");
+			indexed.add_word(u8"écolo");
+
+			BOOST_TEST_CHECK(words_of(indexed.get_suggestions(u8"école", 10, 1)) == (words{ u8"écale", u8"écolo" }));
+		}
+
+		BOOST_TEST_CONTEXT("index follows set operations")
+		{
+			dictionary_creator::Dictionary other(dictionary_creator::Language::French);
+			other.add_word(u8"écolo");
+			other.add_word(u8"écolo");
+			other.add_word(u8"écoles");
+
+			indexed.merge(other);
+			BOOST_TEST_CHECK(words_of(indexed.get_suggestions(u8"école", 10, 1)) == (words{ u8"écolo", u8"écale", u8"écoles" }));
+
+			indexed.subtract(other);
+			BOOST_TEST_CHECK(words_of(indexed.get_suggestions(u8"école", 10, 1)) == (words{ u8"écale" }));
+
+			indexed *= scanned;
+			BOOST_TEST_CHECK(indexed.has_fuzzy_index());
+			BOOST_TEST_CHECK(words_of(indexed.get_suggestions(u8"étole", 10, 1)) == (words{ u8"étoile" }));
+		}
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
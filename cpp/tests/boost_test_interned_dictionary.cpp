@@ -0,0 +1,211 @@
+#define BOOST_TEST_MODULE Interned Dictionary Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "interned_dictionary.h"
+
+#include <string>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(interned_dictionary_alltogether)
+
+	// words spelled from the digits of a number, so that neighbouring numbers land far apart in the symbol table order
+	dictionary_creator::utf8_string spelled(size_t number)
+	{
+		dictionary_creator::utf8_string word;
+		do
+		{
+			word += static_cast<char>('a' + number % 10);
+			number /= 10;
+		} while (number != 0);
+
+		return word + "x";
+	}
+
+	dictionary_creator::Dictionary numbered(size_t first, size_t last, size_t step)
+	{
+		dictionary_creator::Dictionary result(dictionary_creator::Language::English);
+		for (size_t i = first; i < last; i += step)
+		{
+			result.add_word(spelled(i));
+			for (size_t extra = i % 3; extra != 0; --extra)
+			{
+				result.add_word(spelled(i));
+			}
+		}
+
+		return result;
+	}
+
+	void check_same_words(const dictionary_creator::InternedDictionary &interned, const dictionary_creator::Dictionary &expected)
+	{
+		BOOST_TEST_CHECK(interned.total_words() == expected.total_words());
+
+		for (const auto &[letter, words]: expected.get_main_dictionary())
+		{
+			for (const auto &entry: words)
+			{
+				BOOST_TEST_INFO(static_cast<const char *>(*entry));
+				BOOST_TEST_CHECK(interned.get_counter(static_cast<const char *>(*entry)) == entry->get_counter());
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(empty_dictionary)
+	{
+		dictionary_creator::Dictionary empty(dictionary_creator::Language::English);
+		auto interned = empty.intern();
+
+		BOOST_TEST_CHECK(interned.total_words() == 0u);
+		BOOST_TEST_CHECK(interned.contains_word("anything") == false);
+		BOOST_TEST_CHECK(interned.get_counter("anything") == 0u);
+		BOOST_TEST_CHECK((interned.get_language() == dictionary_creator::Language::English));
+		BOOST_TEST_CHECK(&interned.get_symbols() == &dictionary_creator::StringPool::shared_words());
+
+		interned.merge(numbered(0, 10, 1).intern());
+		BOOST_TEST_CHECK(interned.total_words() == 10u);
+		interned.subtract(interned);
+		BOOST_TEST_CHECK(interned.total_words() == 0u);
+	}
+
+	BOOST_AUTO_TEST_CASE(lookups_match_origin)
+	{
+		auto eng = numbered(0, 200, 1);
+		auto interned = eng.intern();
+
+		check_same_words(interned, eng);
+
+		BOOST_TEST_CHECK(std::is_sorted(interned.get_ids().begin(), interned.get_ids().end()));
+		BOOST_TEST_CHECK(interned.get_counters().size() == interned.get_ids().size());
+		BOOST_TEST_CHECK(interned.contains_word(spelled(200)) == false);
+		BOOST_TEST_CHECK(interned.contains_word("") == false);
+		BOOST_TEST_CHECK(interned.memory_usage() >= 200 * (sizeof(dictionary_creator::string_id) + sizeof(size_t)));
+	}
+
+	BOOST_AUTO_TEST_CASE(set_algebra_matches_dictionary)
+	{
+		const std::vector<dictionary_creator::Dictionary> dictionaries = {
+			numbered(0, 1000, 1),
+			numbered(0, 3000, 7),
+			numbered(500, 1500, 1),
+			numbered(990, 1000, 1),
+			numbered(5000, 5001, 1),
+			dictionary_creator::Dictionary(dictionary_creator::Language::English)
+		};
+
+		for (size_t i = 0; i != dictionaries.size(); ++i)
+		{
+			for (size_t j = 0; j != dictionaries.size(); ++j)
+			{
+				BOOST_TEST_CONTEXT("dictionaries " << i << " and " << j)
+				{
+					const auto &left = dictionaries[i];
+					const auto &right = dictionaries[j];
+
+					auto merged = left.intern();
+					merged.merge(right.intern());
+					check_same_words(merged, left + right);
+
+					auto subtracted = left.intern();
+					subtracted.subtract(right.intern());
+					check_same_words(subtracted, left - right);
+
+					const auto intersection = left.intern().intersection_with(right.intern());
+					const auto expected = left * right;
+					BOOST_TEST_CHECK(intersection.total_words() == expected.total_words());
+					for (const auto &[word, counter]: intersection.counted_words())
+					{
+						BOOST_TEST_INFO(word);
+						BOOST_TEST_CHECK(expected.lookup(dictionary_creator::utf8_string{ word }) != nullptr);
+						BOOST_TEST_CHECK(counter == left.lookup(dictionary_creator::utf8_string{ word })->get_counter());
+					}
+				}
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(round_trip)
+	{
+		auto eng = numbered(0, 300, 1);
+		auto restored = dictionary_creator::Dictionary::from_interned(eng.intern());
+
+		BOOST_TEST_CHECK(restored.total_words() == eng.total_words());
+		check_same_words(restored.intern(), eng);
+
+		auto empty = dictionary_creator::Dictionary::from_interned(dictionary_creator::InternedDictionary(dictionary_creator::Language::Russian));
+		BOOST_TEST_CHECK(empty.total_words() == 0u);
+		BOOST_TEST_CHECK((empty.get_language() == dictionary_creator::Language::Russian));
+	}
+
+	BOOST_AUTO_TEST_CASE(own_symbol_table)
+	{
+		dictionary_creator::StringPool symbols;
+		auto eng = numbered(0, 50, 1);
+
+		auto interned = eng.intern(symbols);
+		BOOST_TEST_CHECK(&interned.get_symbols() == &symbols);
+		BOOST_TEST_CHECK(symbols.size() == 50u);
+		check_same_words(interned, eng);
+
+		BOOST_TEST_INFO("looking a word up doesn't intern it");
+		BOOST_TEST_CHECK(interned.contains_word("absent") == false);
+		BOOST_TEST_CHECK(symbols.size() == 50u);
+		BOOST_TEST_CHECK(symbols.find("absent").has_value() == false);
+		BOOST_TEST_CHECK(symbols.find(spelled(7)).has_value());
+	}
+
+	BOOST_AUTO_TEST_CASE(pool_views)
+	{
+		dictionary_creator::StringPool symbols;
+		// enough strings to fill the first chunks of views and start a fourth
+		const size_t count = 8000;
+
+		BOOST_TEST_CONTEXT("views while another thread interns")
+		{
+			std::thread writer([&symbols]()
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					symbols.intern(spelled(i));
+				}
+			});
+
+			size_t checked = 0;
+			while (checked < count)
+			{
+				for (size_t size = symbols.size(); checked < size; ++checked)
+				{
+					BOOST_TEST_INFO(checked);
+					BOOST_TEST_CHECK(symbols.view(static_cast<dictionary_creator::string_id>(checked)) == spelled(checked));
+				}
+			}
+
+			writer.join();
+		}
+
+		BOOST_TEST_CHECK(symbols.size() == count);
+		BOOST_TEST_CHECK(symbols.find(spelled(1023)).value() == 1023u);
+		BOOST_TEST_CHECK(symbols.find(spelled(1024)).value() == 1024u);
+		BOOST_TEST_CHECK(symbols.intern(spelled(3072)) == 3072u);
+		BOOST_CHECK_THROW(symbols.view(static_cast<dictionary_creator::string_id>(count)), std::out_of_range);
+	}
+
+	BOOST_AUTO_TEST_CASE(mismatches_throw)
+	{
+		dictionary_creator::StringPool symbols;
+		auto eng = numbered(0, 10, 1);
+		auto interned = eng.intern();
+
+		BOOST_CHECK_THROW(interned.merge(eng.intern(symbols)), dictionary_creator::dictionary_runtime_error);
+		BOOST_CHECK_THROW(interned.subtract(eng.intern(symbols)), dictionary_creator::dictionary_runtime_error);
+		BOOST_CHECK_THROW(interned.intersection_with(eng.intern(symbols)), dictionary_creator::dictionary_runtime_error);
+
+		const dictionary_creator::InternedDictionary russian(dictionary_creator::Language::Russian);
+		BOOST_CHECK_THROW(interned.merge(russian), dictionary_creator::dictionary_runtime_error);
+		BOOST_CHECK_THROW(interned.subtract(russian), dictionary_creator::dictionary_runtime_error);
+		BOOST_CHECK_THROW(interned.intersection_with(russian), dictionary_creator::dictionary_runtime_error);
+
+		BOOST_TEST_CHECK(interned.total_words() == 10u);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
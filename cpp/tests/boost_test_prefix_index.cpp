@@ -0,0 +1,184 @@
+#define BOOST_TEST_MODULE Prefix Index Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "prefix_index.h"
+#include "dictionary_examples.h"
+
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE(prefix_index_alltogether)
+
+	using d_ex::words_of;
+	using d_ex::make_entry;
+
+	BOOST_AUTO_TEST_CASE(index_on_its_own)
+	{
+		dictionary_creator::PrefixIndex index;
+
+		BOOST_TEST_CHECK(index.complete("", 10).empty());
+
+		index.insert(make_entry("car", 5));
+		index.insert(make_entry("card", 2));
+		index.insert(make_entry("care", 9));
+		index.insert(make_entry("cat", 7));
+		index.insert(make_entry("dog", 100));
+
+		BOOST_TEST_CHECK(index.total_words() == 5u);
+
+		using words = std::vector<dictionary_creator::utf8_string>;
+
+		BOOST_TEST_CHECK(words_of(index.complete("car", 10)) == (words{ "care", "car", "card" }));
+		BOOST_TEST_CHECK(words_of(index.complete("ca", 2)) == (words{ "care", "cat" }));
+		BOOST_TEST_CHECK(words_of(index.complete("", 1)) == (words{ "dog" }));
+		BOOST_TEST_CHECK(index.complete("cart", 3).empty());
+		BOOST_TEST_CHECK(index.complete("ca", 0).empty());
+
+		BOOST_TEST_CONTEXT("erase()")
+		{
+			index.erase("care");
+			index.erase("absent");
+			BOOST_TEST_CHECK(index.total_words() == 4u);
+			BOOST_TEST_CHECK(words_of(index.complete("car", 10)) == (words{ "car", "card" }));
+
+			index.erase("car");
+			index.erase("card");
+			BOOST_TEST_CHECK(index.complete("car", 10).empty());
+			BOOST_TEST_CHECK(words_of(index.complete("c", 10)) == (words{ "cat" }));
+		}
+
+		BOOST_TEST_CONTEXT("clear()")
+		{
+			index.clear();
+			BOOST_TEST_CHECK(index.total_words() == 0u);
+			BOOST_TEST_CHECK(index.complete("", 10).empty());
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(dictionary_completions)
+	{
+		using words = std::vector<dictionary_creator::utf8_string>;
+
+		dictionary_creator::Dictionary indexed(dictionary_creator::Language::French);
+		dictionary_creator::Dictionary scanned(dictionary_creator::Language::French);
+
+		indexed.enable_prefix_index();
+		BOOST_TEST_CHECK(indexed.has_prefix_index());
+		BOOST_TEST_CHECK(scanned.has_prefix_index() == false);
+
+		for (auto word: { u8"école", u8"écran", u8"écran", u8"écrire", u8"écrire", u8"écrire", u8"étoile", u8"eau" })
+		{
+			indexed.add_word(word);
+			scanned.add_word(word);
+		}
+
+		for (auto *dictionary: { &indexed, &scanned })
+		{
+			BOOST_TEST_CHECK(words_of(dictionary->get_completions(u8"éc", 10)) == (words{ u8"écrire", u8"écran", u8"école" }));
+			BOOST_TEST_CHECK(words_of(dictionary->get_completions(u8"é", 1)) == (words{ u8"écrire" }));
+			BOOST_TEST_CHECK(dictionary->get_completions(u8"z", 10).empty());
+			BOOST_TEST_CHECK(dictionary->get_completions("", 100).size() == 5u);
+		}
+
+		BOOST_TEST_CONTEXT("index follows add_word() and remove_word()")
+		{
+			indexed.remove_word(u8"écrire");
+			indexed.add_word(u8"école");
+			indexed.add_word(u8"école");
+			indexed.add_word(u8"écho");
+
+			BOOST_TEST_CHECK(words_of(indexed.get_completions(u8"éc", 10)) == (words{ u8"école", u8"écran", u8"écho" }));
+		}
+
+		BOOST_TEST_CONTEXT("index follows set operations")
+		{
+			dictionary_creator::Dictionary other(dictionary_creator::Language::French);
+			other.add_word(u8"écho");
+			other.add_word(u8"écho");
+			other.add_word(u8"écho");
+			other.add_word(u8"échelle");
+			other.add_proper_noun(u8"école");
+
+			indexed.merge(other);
+			BOOST_TEST_CHECK(words_of(indexed.get_completions(u8"éc", 10)) == (words{ u8"écho", u8"écran", u8"échelle" }));
+
+			indexed.subtract(other);
+			BOOST_TEST_CHECK(words_of(indexed.get_completions(u8"éc", 10)) == (words{ u8"écran" }));
+
+			indexed *= scanned;
+			BOOST_TEST_CHECK(indexed.has_prefix_index());
+			BOOST_TEST_CHECK(words_of(indexed.get_completions(u8"é", 10)) == (words{ u8"écran", u8"étoile" }));
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(completions_without_index)
+	{
+		using words = std::vector<dictionary_creator::utf8_string>;
+
+		dictionary_creator::Dictionary scanned(dictionary_creator::Language::French);
+		BOOST_TEST_REQUIRE(scanned.has_prefix_index() == false);
+
+		// collation puts côte between cote and coté, so the words starting with cô aren't neighbours in their bucket
+		for (auto [word, counter]: std::initializer_list<std::pair<const char *, size_t>>{
+			{ u8"cote", 2 }, { u8"côte", 3 }, { u8"coté", 1 }, { u8"côté", 4 }, { u8"Côme", 1 }, { u8"eau", 5 } })
+		{
+			for (size_t i = 0; i != counter; ++i)
+			{
+				scanned.add_word(word);
+			}
+		}
+
+		BOOST_TEST_CONTEXT("the whole bucket of the first letter is scanned")
+		{
+			BOOST_TEST_CHECK(words_of(scanned.get_completions(u8"cô", 10)) == (words{ u8"côté", u8"côte" }));
+			BOOST_TEST_CHECK(words_of(scanned.get_completions(u8"cot", 10)) == (words{ u8"cote", u8"coté" }));
+			BOOST_TEST_CHECK(words_of(scanned.get_completions(u8"c", 1)) == (words{ u8"côté" }));
+			BOOST_TEST_CHECK(scanned.get_completions(u8"cô", 0).empty());
+		}
+
+		BOOST_TEST_CONTEXT("prefixes are matched byte for byte")
+		{
+			BOOST_TEST_CHECK(words_of(scanned.get_completions(u8"Cô", 10)) == (words{ u8"Côme" }));
+			BOOST_TEST_CHECK(scanned.get_completions(u8"co", 10).size() == 2u);
+		}
+
+		BOOST_TEST_CONTEXT("an empty prefix scans every letter, a letter without words finds nothing")
+		{
+			BOOST_TEST_CHECK(words_of(scanned.get_completions("", 2)) == (words{ u8"eau", u8"côté" }));
+			BOOST_TEST_CHECK(scanned.get_completions("", 100).size() == 6u);
+			BOOST_TEST_CHECK(scanned.get_completions(u8"z", 10).empty());
+		}
+
+		BOOST_TEST_CONTEXT("the same words as the index, equal counters in either order")
+		{
+			dictionary_creator::Dictionary indexed = scanned;
+			indexed.enable_prefix_index();
+
+			auto counters_of = [] (const dictionary_creator::subset_t &entries)
+			{
+				std::vector<size_t> counters;
+				for (const auto &entry: entries)
+				{
+					counters.push_back(entry->get_counter());
+				}
+				return counters;
+			};
+			auto sorted_words_of = [] (const dictionary_creator::subset_t &entries)
+			{
+				auto words = words_of(entries);
+				std::sort(words.begin(), words.end());
+				return words;
+			};
+
+			for (auto prefix: { u8"", u8"c", u8"co", u8"cô", u8"côt", u8"e", u8"Cô", u8"x" })
+			{
+				BOOST_TEST_INFO("prefix " << prefix);
+				const auto from_scan = scanned.get_completions(prefix, 10);
+				const auto from_index = indexed.get_completions(prefix, 10);
+				BOOST_TEST_CHECK(counters_of(from_scan) == counters_of(from_index));
+				BOOST_TEST_CHECK(sorted_words_of(from_scan) == sorted_words_of(from_index));
+			}
+		}
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
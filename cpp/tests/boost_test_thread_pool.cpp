@@ -0,0 +1,75 @@
+#define BOOST_TEST_MODULE Thread Pool Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(thread_pool_alltogether)
+
+	BOOST_AUTO_TEST_CASE(every_job_once)
+	{
+		for (size_t threads: { 1, 2, 4, 16 })
+		{
+			BOOST_TEST_CONTEXT(threads << " threads")
+			{
+				dictionary_creator::ThreadPool pool(threads);
+				BOOST_TEST_CHECK(pool.size() == threads);
+
+				for (size_t jobs: { 0, 1, 3, 1000 })
+				{
+					std::vector<std::atomic<size_t>> runs(jobs);
+					std::vector<size_t> weights(jobs);
+					std::iota(weights.begin(), weights.end(), size_t{ 0 });
+
+					pool.run(weights, [&runs] (size_t i) { ++runs[i]; });
+
+					BOOST_TEST_INFO(jobs << " jobs");
+					BOOST_TEST_CHECK(std::all_of(runs.begin(), runs.end(), [] (const auto &count) { return count == 1; }));
+				}
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(heaviest_first)
+	{
+		// a single thread takes the jobs one by one, in the order they are handed out
+		dictionary_creator::ThreadPool pool(1);
+
+		std::vector<size_t> order;
+		pool.run({ 5, 50, 1, 50, 20 }, [&order] (size_t i) { order.push_back(i); });
+
+		BOOST_TEST_CHECK(order == (std::vector<size_t>{ 1, 3, 4, 0, 2 }));
+	}
+
+	BOOST_AUTO_TEST_CASE(failing_jobs)
+	{
+		dictionary_creator::ThreadPool pool(4);
+
+		std::atomic<size_t> finished = 0;
+		const std::vector<size_t> weights(100, 1);
+
+		BOOST_CHECK_THROW(pool.run(weights, [&finished] (size_t i)
+			{
+				if (i % 10 == 0)
+				{
+					throw std::runtime_error("job failed");
+				}
+				++finished;
+			}), std::runtime_error);
+
+		BOOST_TEST_INFO("the rest of the batch is done all the same");
+		BOOST_TEST_CHECK(finished == 90u);
+
+		BOOST_TEST_INFO("the pool keeps working");
+		finished = 0;
+		pool.run(weights, [&finished] (size_t) { ++finished; });
+		BOOST_TEST_CHECK(finished == 100u);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
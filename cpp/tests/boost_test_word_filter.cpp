@@ -0,0 +1,161 @@
+#define BOOST_TEST_MODULE Word Filter Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "word_filter.h"
+#include "dictionary_examples.h"
+
+#include <random>
+#include <set>
+
+BOOST_AUTO_TEST_SUITE(word_filter_alltogether)
+
+	using d_ex::numbered_words;
+
+	BOOST_AUTO_TEST_CASE(filter_on_its_own)
+	{
+		const auto present = numbered_words(0, 10000, "word");
+		const auto absent = numbered_words(0, 100000, "missing");
+
+		for (double rate: { 0.1, 0.01, 0.001 })
+		{
+			BOOST_TEST_CONTEXT("false positive rate " << rate)
+			{
+				dictionary_creator::WordFilter filter(rate, present.size());
+				BOOST_TEST_CHECK(filter.get_capacity() == present.size());
+				BOOST_TEST_CHECK(filter.get_false_positive_rate() == rate);
+
+				for (const auto &word: present)
+				{
+					filter.insert(word);
+				}
+				BOOST_TEST_CHECK(filter.needs_rebuild() == false);
+
+				size_t false_negatives = 0;
+				for (const auto &word: present)
+				{
+					false_negatives += filter.may_contain(word) ? 0 : 1;
+				}
+				BOOST_TEST_CHECK(false_negatives == 0u);
+
+				size_t false_positives = 0;
+				for (const auto &word: absent)
+				{
+					false_positives += filter.may_contain(word) ? 1 : 0;
+				}
+				BOOST_TEST_CHECK(static_cast<double>(false_positives) / absent.size() < rate * 2);
+			}
+		}
+
+		BOOST_TEST_CONTEXT("insert() and rebuild requests")
+		{
+			dictionary_creator::WordFilter filter;
+			BOOST_TEST_CHECK(filter.get_capacity() == 1024u);
+			BOOST_TEST_CHECK(filter.may_contain("word") == false);
+			BOOST_TEST_CHECK(filter.insert("word"));
+			BOOST_TEST_CHECK(filter.insert("word") == false);
+			BOOST_TEST_CHECK(filter.may_contain("word"));
+
+			BOOST_TEST_INFO("words forgotten stay, until half of them are");
+			for (size_t i = 0; i != 512; ++i)
+			{
+				filter.forget();
+			}
+			BOOST_TEST_CHECK(filter.may_contain("word"));
+			BOOST_TEST_CHECK(filter.needs_rebuild() == false);
+			filter.forget();
+			BOOST_TEST_CHECK(filter.needs_rebuild());
+
+			filter.clear();
+			BOOST_TEST_CHECK(filter.may_contain("word") == false);
+			BOOST_TEST_CHECK(filter.needs_rebuild() == false);
+
+			for (const auto &word: numbered_words(0, 1025, "word"))
+			{
+				filter.insert(word);
+			}
+			BOOST_TEST_CHECK(filter.needs_rebuild());
+		}
+
+		BOOST_CHECK_THROW(dictionary_creator::WordFilter(0.0), dictionary_creator::dictionary_runtime_error);
+		BOOST_CHECK_THROW(dictionary_creator::WordFilter(1.0), dictionary_creator::dictionary_runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(filter_of_dictionary)
+	{
+		dictionary_creator::Dictionary dictionary(dictionary_creator::Language::English);
+		dictionary.add_word("before");
+
+		BOOST_TEST_CHECK(dictionary.has_word_filter() == false);
+		dictionary.enable_word_filter(0.05);
+		BOOST_TEST_CHECK(dictionary.has_word_filter());
+		BOOST_TEST_CHECK(dictionary.lookup("before") != nullptr);
+		BOOST_TEST_CHECK(dictionary.lookup("after") == nullptr);
+
+		std::mt19937 engine(7);
+		std::set<dictionary_creator::utf8_string> reference{ "before" };
+		const auto words = numbered_words(0, 5000, "w");
+
+		BOOST_TEST_INFO("the filter grows and follows additions and removals");
+		for (size_t round = 0; round != 20000; ++round)
+		{
+			const auto &word = words[engine() % words.size()];
+
+			if (engine() % 3 == 0)
+			{
+				dictionary.remove_word(word);
+				reference.erase(word);
+			}
+			else
+			{
+				dictionary.add_word(word);
+				reference.insert(word);
+			}
+		}
+
+		auto matches_reference = [&words, &reference] (const dictionary_creator::Dictionary &checked)
+		{
+			for (const auto &word: words)
+			{
+				if ((checked.lookup(word) != nullptr) != (reference.count(word) != 0))
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		BOOST_TEST_CHECK(matches_reference(dictionary));
+
+		BOOST_TEST_CONTEXT("copies and set operations")
+		{
+			auto copy = dictionary;
+			BOOST_TEST_CHECK(copy.has_word_filter());
+			BOOST_TEST_CHECK(matches_reference(copy));
+
+			dictionary_creator::Dictionary addition(dictionary_creator::Language::English);
+			addition.add_word("w1");
+			addition.add_word("brand new");
+
+			copy.merge(std::move(addition));
+			BOOST_TEST_CHECK(copy.lookup("brand new") != nullptr);
+			BOOST_TEST_CHECK(copy.lookup("w1") != nullptr);
+
+			copy.subtract(copy);
+			BOOST_TEST_CHECK(copy.lookup("brand new") == nullptr);
+			copy.add_word("brand new");
+			BOOST_TEST_CHECK(copy.lookup("brand new") != nullptr);
+
+			copy *= dictionary;
+			BOOST_TEST_CHECK(copy.has_word_filter());
+			BOOST_TEST_CHECK(copy.lookup("brand new") == nullptr);
+
+			dictionary_creator::Dictionary proper(dictionary_creator::Language::English);
+			proper.add_proper_noun(*reference.begin());
+			copy = dictionary;
+			copy.merge(proper);
+			BOOST_TEST_CHECK(copy.lookup(*reference.begin()) == nullptr);
+		}
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+#define BOOST_TEST_MODULE Word Sketch Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "dictionary_hash.h"
+#include "word_sketch.h"
+#include "dictionary_examples.h"
+
+#include <sstream>
+
+BOOST_AUTO_TEST_SUITE(word_sketch_alltogether)
+
+	using d_ex::numbered_words;
+
+	dictionary_creator::WordSketch sketch_of(const std::vector<dictionary_creator::utf8_string> &words, size_t size = dictionary_creator::WordSketch::default_size)
+	{
+		dictionary_creator::WordSketch sketch(size);
+		for (const auto &word: words)
+		{
+			sketch.insert(word);
+		}
+		return sketch;
+	}
+
+	std::string bytes_of(const dictionary_creator::WordSketch &sketch)
+	{
+		std::ostringstream stream;
+		sketch.write(stream);
+		return stream.str();
+	}
+
+	// a sketch maintained through removals may hold fewer hashes than one built at once,
+	// but the smallest ones of both have to be the same
+	bool estimates_alike(const dictionary_creator::WordSketch &maintained, const dictionary_creator::WordSketch &built)
+	{
+		return maintained.needs_rebuild() == false && maintained.jaccard(built) == 1.0;
+	}
+
+	// compared with a sketch enabled on a copy of the words only, which is built from scratch
+	bool sketch_follows(const dictionary_creator::Dictionary &dictionary)
+	{
+		auto words = dictionary_creator::Dictionary::from_interned(dictionary.intern());
+		words.enable_word_sketch(dictionary.get_word_sketch().size());
+
+		return estimates_alike(dictionary.get_word_sketch(), words.get_word_sketch());
+	}
+
+	BOOST_AUTO_TEST_CASE(sketch_on_its_own)
+	{
+		BOOST_TEST_CONTEXT("sketches holding all of their words are exact")
+		{
+			const auto left = sketch_of(numbered_words(0, 100));
+			const auto right = sketch_of(numbered_words(50, 150));
+
+			BOOST_TEST_CHECK(left.estimated_words() == 100.0);
+			BOOST_TEST_CHECK(left.jaccard(right) == 50.0 / 150.0);
+			BOOST_TEST_CHECK(left.intersection_size(right) == 50.0);
+			BOOST_TEST_CHECK(left.jaccard(left) == 1.0);
+			BOOST_TEST_CHECK(left.jaccard(sketch_of(numbered_words(0, 100, "other"))) == 0.0);
+			BOOST_TEST_CHECK(dictionary_creator::WordSketch().jaccard(dictionary_creator::WordSketch()) == 0.0);
+		}
+
+		BOOST_TEST_CONTEXT("larger vocabularies are estimated")
+		{
+			const auto left = sketch_of(numbered_words(0, 20000));
+			const auto right = sketch_of(numbered_words(10000, 30000));
+
+			BOOST_TEST_CHECK(left.jaccard(right) == 1.0 / 3.0, boost::test_tools::tolerance(0.25));
+			BOOST_TEST_CHECK(left.intersection_size(right) == 10000.0, boost::test_tools::tolerance(0.25));
+			BOOST_TEST_CHECK(left.estimated_words() == 20000.0, boost::test_tools::tolerance(0.25));
+			BOOST_TEST_CHECK(left.jaccard(left) == 1.0);
+			BOOST_TEST_CHECK(left.memory_usage() <= (2 * left.size() + 1) * sizeof(uint64_t));
+		}
+
+		BOOST_TEST_CONTEXT("sketches of different sizes compare by the smaller one")
+		{
+			const auto words = numbered_words(0, 5000);
+			BOOST_TEST_CHECK(sketch_of(words, 64).jaccard(sketch_of(words, 512)) == 1.0);
+		}
+
+		BOOST_CHECK_THROW(dictionary_creator::WordSketch(0), dictionary_creator::dictionary_runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(erasing_and_rebuild_requests)
+	{
+		const auto words = numbered_words(0, 100);
+		auto sketch = sketch_of(words, 8);
+		BOOST_TEST_CHECK(sketch.needs_rebuild() == false);
+
+		BOOST_TEST_INFO("words never inserted change nothing");
+		const auto before = bytes_of(sketch);
+		sketch.erase("absent");
+		sketch.insert(words.front());
+		BOOST_TEST_CHECK(bytes_of(sketch) == before);
+
+		for (const auto &word: words)
+		{
+			sketch.erase(word);
+		}
+		BOOST_TEST_CHECK(sketch.needs_rebuild());
+
+		sketch.clear();
+		BOOST_TEST_CHECK(sketch.needs_rebuild() == false);
+		BOOST_TEST_CHECK(sketch.estimated_words() == 0.0);
+
+		BOOST_TEST_INFO("a sketch holding all of its words never needs a rebuild");
+		auto small = sketch_of(numbered_words(0, 10), 8);
+		for (const auto &word: numbered_words(0, 10))
+		{
+			small.erase(word);
+			BOOST_TEST_CHECK(small.needs_rebuild() == false);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(maintained_by_dictionary)
+	{
+		dictionary_creator::Dictionary eng(dictionary_creator::Language::English);
+		BOOST_TEST_CHECK(eng.has_word_sketch() == false);
+
+		eng.enable_word_sketch(32);
+		BOOST_TEST_CHECK(eng.has_word_sketch());
+		BOOST_TEST_CHECK(eng.get_word_sketch().size() == 32u);
+
+		for (const auto &word: numbered_words(0, 3000))
+		{
+			eng.add_word(word);
+		}
+
+		BOOST_TEST_INFO("adding words");
+		BOOST_TEST_CHECK(bytes_of(eng.get_word_sketch()) == bytes_of(sketch_of(numbered_words(0, 3000), 32)));
+
+		BOOST_TEST_INFO("removing most of them rebuilds the sketch on the way");
+		for (const auto &word: numbered_words(0, 2900))
+		{
+			eng.remove_word(word);
+		}
+		BOOST_TEST_CHECK(estimates_alike(eng.get_word_sketch(), sketch_of(numbered_words(2900, 3000), 32)));
+
+		dictionary_creator::Dictionary other(dictionary_creator::Language::English);
+		for (const auto &word: numbered_words(2950, 6000))
+		{
+			other.add_word(word);
+		}
+
+		BOOST_TEST_INFO("set algebra");
+		eng.merge(other);
+		BOOST_TEST_CHECK(sketch_follows(eng));
+		eng.subtract(other);
+		BOOST_TEST_CHECK(sketch_follows(eng));
+
+		dictionary_creator::ThreadPool pool(2);
+		eng.merge(other, pool);
+		BOOST_TEST_CHECK(sketch_follows(eng));
+		eng.subtract(other, pool);
+		BOOST_TEST_CHECK(sketch_follows(eng));
+
+		eng.merge(dictionary_creator::Dictionary(other));
+		eng *= other;
+		BOOST_TEST_CHECK(eng.has_word_sketch());
+		BOOST_TEST_CHECK(sketch_follows(eng));
+
+		eng -= eng;
+		BOOST_TEST_CHECK(eng.get_word_sketch().estimated_words() == 0.0);
+	}
+
+	BOOST_AUTO_TEST_CASE(written_and_read)
+	{
+		const auto sketch = sketch_of(numbered_words(0, 5000), 64);
+
+		std::stringstream stream;
+		sketch.write(stream);
+		const auto read = dictionary_creator::WordSketch::read(stream);
+
+		BOOST_TEST_CHECK(read.size() == 64u);
+		BOOST_TEST_CHECK(bytes_of(read) == bytes_of(sketch));
+		BOOST_TEST_CHECK(read.jaccard(sketch) == 1.0);
+
+		std::istringstream foreign("not a sketch at all");
+		BOOST_CHECK_THROW(dictionary_creator::WordSketch::read(foreign), dictionary_creator::dictionary_runtime_error);
+
+		auto bytes = bytes_of(sketch);
+		std::istringstream truncated(bytes.substr(0, bytes.size() - 3));
+		BOOST_CHECK_THROW(dictionary_creator::WordSketch::read(truncated), dictionary_creator::dictionary_runtime_error);
+
+		// the first hash turned larger than the second one
+		bytes[8 * 4 + 7] = static_cast<char>(0xFF);
+		std::istringstream unsorted(bytes);
+		BOOST_CHECK_THROW(dictionary_creator::WordSketch::read(unsorted), dictionary_creator::dictionary_runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(hashes_independent_of_the_host)
+	{
+		// sketches are saved and compared across machines, so these values may never depend on the byte order of the host
+		BOOST_TEST_CHECK(dictionary_creator::hash_bytes("") == 0u);
+		BOOST_TEST_CHECK(dictionary_creator::hash_bytes("sketch") == 0x385BD43E38DC9E5Eull);
+		BOOST_TEST_CHECK(dictionary_creator::hash_bytes(u8"Häuser und Hütten", 7) == 0x94FD86CE3B92E639ull);
+
+		BOOST_TEST_CHECK(dictionary_creator::little_endian_chunk("\x01\x02", 2) == 0x0201u);
+		BOOST_TEST_CHECK(dictionary_creator::little_endian_chunk("\xFF\x00\x00\x00\x00\x00\x00\x80", 8) == 0x80000000000000FFull);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
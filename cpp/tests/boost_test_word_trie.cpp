@@ -0,0 +1,154 @@
+#define BOOST_TEST_MODULE Word Trie Regress Test
+#include <boost/test/unit_test.hpp>
+
+#include "dictionary.h"
+#include "word_trie.h"
+
+#include <utility>
+
+BOOST_AUTO_TEST_SUITE(word_trie_alltogether)
+
+	using word_counters = std::vector<std::pair<dictionary_creator::utf8_string, size_t>>;
+
+	word_counters letter_words(const dictionary_creator::WordTrie &trie, dictionary_creator::letter_type letter)
+	{
+		word_counters result;
+		trie.for_each_in_letter(std::move(letter), [&result] (const dictionary_creator::utf8_string &word, size_t counter)
+			{
+				result.emplace_back(word, counter);
+			});
+		return result;
+	}
+
+	BOOST_AUTO_TEST_CASE(incremental_insertion)
+	{
+		dictionary_creator::WordTrie trie(dictionary_creator::Language::German);
+
+		BOOST_TEST_CHECK(trie.total_words() == 0u);
+		BOOST_TEST_CHECK(trie.contains_word("Haus") == false);
+
+		BOOST_TEST_CHECK(trie.add_word("Haus"));
+		BOOST_TEST_CHECK(trie.add_word("Hauses"));
+		BOOST_TEST_CHECK(trie.add_word("Haus") == false);
+		BOOST_TEST_CHECK(trie.add_word("hausen", 5));
+		BOOST_TEST_CHECK(trie.add_word(u8"Häuser"));
+
+		BOOST_TEST_CHECK(trie.total_words() == 4u);
+		BOOST_TEST_CHECK(trie.get_counter("Haus") == 2u);
+		BOOST_TEST_CHECK(trie.get_counter("hausen") == 5u);
+		BOOST_TEST_CHECK(trie.get_counter("Hau") == 0u);
+		BOOST_TEST_CHECK(trie.contains_word("Hause") == false);
+		BOOST_TEST_CHECK(trie.contains_word("Hausess") == false);
+
+		BOOST_TEST_CONTEXT("ordered iteration per letter")
+		{
+			auto words = letter_words(trie, "h");
+			BOOST_TEST_REQUIRE(words.size() == 4u);
+			BOOST_TEST_CHECK(words[0].first == "Haus");
+			BOOST_TEST_CHECK(words[1].first == "hausen");
+			BOOST_TEST_CHECK(words[1].second == 5u);
+			BOOST_TEST_CHECK(words[2].first == u8"Häuser");
+			BOOST_TEST_CHECK(words[3].first == "Hauses");
+
+			BOOST_TEST_CHECK(letter_words(trie, "Z").empty());
+		}
+
+		BOOST_TEST_CONTEXT("remove_word()")
+		{
+			BOOST_TEST_CHECK(trie.remove_word("Haus"));
+			BOOST_TEST_CHECK(trie.remove_word("Haus") == false);
+			BOOST_TEST_CHECK(trie.contains_word("Haus") == false);
+			BOOST_TEST_CHECK(trie.contains_word("Hauses"));
+			BOOST_TEST_CHECK(trie.total_words() == 3u);
+		}
+
+		BOOST_TEST_CONTEXT("iteration follows changes made after an earlier one")
+		{
+			using words = std::vector<dictionary_creator::utf8_string>;
+			auto words_of = [&trie] (dictionary_creator::letter_type letter)
+			{
+				words result;
+				for (const auto &[word, counter]: letter_words(trie, std::move(letter)))
+				{
+					result.push_back(word);
+				}
+				return result;
+			};
+
+			BOOST_TEST_CHECK(words_of("H") == (words{ "hausen", u8"Häuser", "Hauses" }));
+
+			trie.add_word("Hausarzt");
+			trie.add_word("hausen");
+			BOOST_TEST_CHECK(words_of("H") == (words{ "Hausarzt", "hausen", u8"Häuser", "Hauses" }));
+			BOOST_TEST_CHECK(trie.get_counter("hausen") == 6u);
+			BOOST_TEST_CHECK(letter_words(trie, "H")[1].second == 6u);
+
+			trie.add_word("Haus");
+			trie.remove_word("Hauses");
+			BOOST_TEST_CHECK(words_of("H") == (words{ "Haus", "Hausarzt", "hausen", u8"Häuser" }));
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(built_from_dictionary)
+	{
+		dictionary_creator::Dictionary rus(dictionary_creator::Language::Russian);
+		for (auto word: { u8"ёжик", u8"ежевика", u8"ель", u8"ель", u8"ёлка", u8"волк" })
+		{
+			rus.add_word(word);
+		}
+
+		dictionary_creator::WordTrie trie(rus);
+
+		BOOST_TEST_CHECK((trie.get_language() == dictionary_creator::Language::Russian));
+		BOOST_TEST_CHECK(trie.total_words() == rus.total_words());
+		BOOST_TEST_CHECK(trie.get_counter(u8"ель") == 2u);
+		BOOST_TEST_CHECK(trie.get_letters().size() == rus.get_main_dictionary().size());
+		BOOST_TEST_CHECK(letter_words(trie, "w").empty());
+		BOOST_TEST_CHECK(trie.contains_word("wolf") == false);
+
+		BOOST_TEST_INFO("per letter order matches the dictionary one");
+		for (const auto &[letter, entries]: rus.get_main_dictionary())
+		{
+			auto words = letter_words(trie, letter);
+			BOOST_TEST_REQUIRE(words.size() == entries.size());
+
+			auto word = words.begin();
+			for (const auto &entry: entries)
+			{
+				BOOST_TEST_CHECK(word->first == entry->get_word());
+				BOOST_TEST_CHECK(word->second == entry->get_counter());
+				++word;
+			}
+		}
+
+		BOOST_TEST_CHECK(trie.memory_usage() > 0u);
+	}
+
+	BOOST_AUTO_TEST_CASE(dictionary_order)
+	{
+		dictionary_creator::Dictionary deu(dictionary_creator::Language::German);
+		for (auto word: { "Haus", "Hauses", "hausen", u8"Häuser", u8"häuslich", "Hausarzt", u8"Höhe", "hoch", "Hof", u8"Hütte", "Hut", "hut" })
+		{
+			deu.add_word(word);
+		}
+
+		dictionary_creator::WordTrie trie(deu);
+
+		for (const auto &[letter, entries]: deu.get_main_dictionary())
+		{
+			BOOST_TEST_CONTEXT("letter " << letter)
+			{
+				const auto words = letter_words(trie, letter);
+				BOOST_TEST_REQUIRE(words.size() == entries.size());
+
+				auto entry = entries.begin();
+				for (const auto &[word, counter]: words)
+				{
+					BOOST_TEST_CHECK(word == (*entry)->get_word());
+					BOOST_TEST_CHECK(counter == (*entry++)->get_counter());
+				}
+			}
+		}
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,42 @@
+#ifndef DICTIONARY_EXAMPLES_H
+#define DICTIONARY_EXAMPLES_H
+
+#include "dictionary.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// entries and words shared by the tests of the structures built on top of Dictionary
+namespace d_ex
+{
+	inline std::vector<dictionary_creator::utf8_string> words_of(const dictionary_creator::subset_t &entries)
+	{
+		std::vector<dictionary_creator::utf8_string> words;
+		for (const auto &entry: entries)
+		{
+			words.push_back(entry->get_word());
+		}
+		return words;
+	}
+
+	// prefix followed by each number of [first, last)
+	inline std::vector<dictionary_creator::utf8_string> numbered_words(size_t first, size_t last, const char *prefix = "word")
+	{
+		std::vector<dictionary_creator::utf8_string> words;
+		for (size_t i = first; i != last; ++i)
+		{
+			words.push_back(prefix + std::to_string(i));
+		}
+		return words;
+	}
+
+	inline std::shared_ptr<dictionary_creator::Entry> make_entry(const char *word, size_t counter)
+	{
+		auto entry = std::make_shared<dictionary_creator::Entry>(word);
+		entry->set_counter(counter);
+		return entry;
+	}
+}
+
+#endif